@@ -196,6 +196,7 @@ public:
     MatchVector                 exec(const std::string& subject)
                                     { return exec(subject.c_str(), subject.length()); }
     MatchVector                 exec_next(const Match& last);
+    int                         exec_offsets(const char* subject, size_t length, std::vector<int>& offsets, int start = 0) const;
     bool                        find(const char* subject)
                                     { return exec(subject, strlen(subject)).size() > 0; }
     bool                        find(const std::string& subject)
@@ -1738,7 +1739,11 @@ public:
                                 ~WaitCursor();
 };
 }
+#include <atomic>
+#include <map>
 #include <set>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <inttypes.h>
@@ -1753,6 +1758,7 @@ class SplitGroup;
 namespace fle {
 class Editor;
 class FindReplace;
+class LiteralSearch;
 class Message;
 class TextBuffer;
 class View;
@@ -1762,6 +1768,7 @@ typedef std::set<std::string>                   StringSet;
 typedef std::unordered_map<std::string, int>    StringIntHash;
 typedef std::unordered_set<std::string>         StringHash;
 typedef std::vector<Message*>                   MessageVector;
+typedef std::vector<std::pair<int, int>>        RangeVector;
 enum class FBinFile {
     NO,
     TEXT,
@@ -1897,6 +1904,12 @@ enum class FSaveWord {
     NO,
     YES,
 };
+enum class FScope {
+    ALL,
+    CODE,
+    COMMENTS,
+    STRINGS,
+};
 enum class FSearchDir {
     FORWARD,
     BACKWARD,
@@ -1918,6 +1931,10 @@ enum class FTab {
     HARD,
     SOFT,
 };
+enum class FTerms {
+    NO,
+    YES,
+};
 enum class FTrim {
     NO,
     YES,
@@ -1972,21 +1989,25 @@ namespace info {
     static const std::string ASK_RELOAD           = "File %s has been changed on disk\nWould you like to load it again and discard changes?";
     static const std::string BACKUP_LOADED        = "file is missing but found backup file!";
     static const std::string BIN_LOADED           = "Binary file has been loaded as text";
+    static const std::string CANCELLED            = "Operation was cancelled and all changes were undone";
     static const std::string FILE_RELOAD          = "File changed on disk and reloaded";
     static const std::string FILE_WRAPPED         = "Word wrapping has been turned on due to very long text lines";
     static const std::string FOUND_LINES          = "Found %u lines in %d mS";
     static const std::string FOUND_STRING_POS     = "Found string at pos %d";
     static const std::string FOUND_STRING_LINE    = "Found string at line %d";
     static const std::string FOUND_STRING_LINECOL = "Found string at line %d, column %d";
+    static const std::string FOUND_STRINGS        = "Found %d matches for <%s> in %d mS";
     static const std::string HEX_LOADED           = "Binary file has been loaded as hex";
     static const std::string NO_SPACES_REPLACED   = "Unable to convert spaces to tabs!";
     static const std::string NO_STRINGS_REPLACED  = "Unable to replace <%s> with <%s>";
     static const std::string NO_STRING_FOUND      = "Unable to find <%s>";
     static const std::string NO_TABS_REPLACED     = "Unable to convert tabs to spaces!";
+    static const std::string NOT_STYLED           = "Text has no syntax styling, unable to limit the search scope";
     static const std::string PAIRS                = "Could not found matching pairs";
     static const std::string REDID_CHANGES        = "Redid %d changes";
     static const std::string REMOVED_TRAILING     = "Removed whitespace from %u lines";
     static const std::string REPLACED_STRINGS     = "Replaced %u strings in %d mS";
+    static const std::string SEARCHING            = "Searching for <%s>, found %d matches so far";
     static const std::string SPACES_REPLACED      = "Replaced spaces with %d tabs";
     static const std::string STYLE_OFF            = "Styling has been turned off!";
     static const std::string TABS_REPLACED        = "Replaced %d tabs with spaces";
@@ -2082,6 +2103,16 @@ namespace limits {
     extern const size_t         STYLE_FILESIZE_MIN;
     extern const size_t         STYLE_FILESIZE_STEP;
     extern size_t               STYLE_FILESIZE_VAL;
+    extern const size_t         UNDO_MEMORY_ALL_DEF;
+    extern const size_t         UNDO_MEMORY_ALL_MAX;
+    extern const size_t         UNDO_MEMORY_ALL_MIN;
+    extern const size_t         UNDO_MEMORY_ALL_STEP;
+    extern size_t               UNDO_MEMORY_ALL_VAL;
+    extern const size_t         UNDO_MEMORY_DEF;
+    extern const size_t         UNDO_MEMORY_MAX;
+    extern const size_t         UNDO_MEMORY_MIN;
+    extern const size_t         UNDO_MEMORY_STEP;
+    extern size_t               UNDO_MEMORY_VAL;
     extern const size_t         WRAP_LINE_LENGTH_DEF;
     extern const size_t         WRAP_LINE_LENGTH_MAX;
     extern const size_t         WRAP_LINE_LENGTH_MIN;
@@ -2327,6 +2358,7 @@ struct Config {
     bool                        pref_linenumber;
     bool                        pref_statusbar;
     bool                        pref_undo_buffer;
+    bool                        pref_undo_compress;
     gnu::file::File             pref_backup;
     int                         pref_cursor;
     int                         pref_shrink_status;
@@ -2474,6 +2506,128 @@ namespace help {
     std::string                 pcre();
     std::string                 replace_text();
 }
+class IncrementalSearch {
+public:
+    static const int            CHUNK = 1'000'000;
+    static const int            COPY  = 16'000'000;
+                                IncrementalSearch(const IncrementalSearch&) = delete;
+                                IncrementalSearch(IncrementalSearch&&) = delete;
+    IncrementalSearch&          operator=(const IncrementalSearch&) = delete;
+    IncrementalSearch&          operator=(IncrementalSearch&&) = delete;
+                                IncrementalSearch();
+                                ~IncrementalSearch();
+    void                        cancel();
+    bool                        copy(const TextBuffer& buffer, int max);
+    int                         count() const
+                                    { return _count; }
+    const std::string&          err() const
+                                    { return _err; }
+    const std::string&          find_string() const
+                                    { return _find; }
+    bool                        has_snapshot() const
+                                    { return _text != nullptr; }
+    void                        invalidate();
+    bool                        is_done() const
+                                    { return _done; }
+    bool                        match_case() const
+                                    { return _match_case; }
+    int                         origin() const
+                                    { return _origin; }
+    bool                        regex() const
+                                    { return _regex; }
+    void                        snapshot(int length, int origin, int line);
+    bool                        start(const std::string& find, bool match_case, bool regex);
+    int64_t                     start_time() const
+                                    { return _time; }
+    bool                        take_nearest(int& start, int& end);
+    bool                        take_ranges(RangeVector& ranges);
+private:
+    void                        _add(int start, int end);
+    void                        _search_literal(const LiteralSearch& search, int from, int to);
+    void                        _search_regex(const gnu::pcre8::PCRE& rx, int from, int to);
+    bool                        _wait(int start, int end) const;
+    static void                 ThreadFunc(IncrementalSearch* self, std::string find, bool match_case, bool regex);
+    RangeVector                 _ranges;
+    bool                        _match_case;
+    bool                        _regex;
+    bool                        _taken;
+    char*                       _text;
+    int                         _length;
+    int                         _line;
+    int                         _origin;
+    int64_t                     _time;
+    size_t                      _wrap;
+    std::atomic<bool>           _cancel;
+    std::atomic<bool>           _done;
+    std::atomic<int>            _copied;
+    std::atomic<int>            _count;
+    std::atomic<int>            _nearest_end;
+    std::atomic<int>            _nearest_start;
+    std::string                 _err;
+    std::string                 _find;
+    std::thread                 _thread;
+};
+class LiteralSearch {
+public:
+    static const int            HORSPOOL_LEN = 16;
+                                LiteralSearch(const std::string& find, bool match_case);
+    int                         find(const char* in, int in_len, int start) const;
+    const std::string&          find_string() const
+                                    { return _find; }
+    bool                        is_fast() const
+                                    { return _fast; }
+    int                         length() const
+                                    { return static_cast<int>(_find.length()); }
+    bool                        match_case() const
+                                    { return _match_case; }
+    int                         rfind(const char* in, int in_len, int start) const;
+    static inline unsigned char Lower(unsigned char c)
+                                    { return (c >= 'A' && c <= 'Z') ? c + 32 : c; }
+private:
+    bool                        _compare(const char* in) const;
+    bool                        _fast;
+    bool                        _match_case;
+    int                         _skip[256];
+    std::string                 _find;
+    std::string                 _needle;
+};
+class MatchIndex {
+public:
+    static const size_t         MAX_RANGES = 1'000'000;
+                                MatchIndex(const MatchIndex&) = delete;
+                                MatchIndex(MatchIndex&&) = delete;
+    MatchIndex&                 operator=(const MatchIndex&) = delete;
+    MatchIndex&                 operator=(MatchIndex&&) = delete;
+                                MatchIndex()
+                                    { _match_case = _regex = _stale = false; _paused = _shift = 0; _split = 0; }
+    void                        clear()
+                                    { _find = ""; _ranges.clear(); _stale = false; _shift = 0; _split = 0; }
+    const std::string&          find_string() const
+                                    { return _find; }
+    bool                        is_empty() const
+                                    { return _ranges.size() == 0; }
+    bool                        pause(bool pause);
+    void                        rebuild(TextBuffer& buffer);
+    void                        set(const std::string& find, bool match_case, bool regex, RangeVector& ranges);
+    bool                        update(TextBuffer& buffer, int pos, int inserted_size, int deleted_size);
+    void                        visible(int first, int last, RangeVector& out) const;
+private:
+    std::pair<int, int>         _at(size_t index) const
+                                    { return (index < _split) ? _ranges[index] : std::make_pair(_ranges[index].first + _shift, _ranges[index].second + _shift); }
+    size_t                      _first(int pos) const;
+    size_t                      _lower(int pos) const;
+    void                        _move_split(size_t index);
+    void                        _search(const std::string& text, int offset, RangeVector& out) const;
+    RangeVector                 _ranges;
+    bool                        _match_case;
+    bool                        _regex;
+    bool                        _stale;
+    int                         _paused;
+    int                         _shift;
+    size_t                      _split;
+    gnu::pcre8::PCRE            _rx;
+    std::string                 _find;
+};
 class Message {
 public:
     enum class CTRL {
@@ -2494,6 +2648,69 @@ private:
     int                         _id;
     Config&                     _config;
 };
+class MultiSearch {
+public:
+                                MultiSearch(const std::vector<std::string>& terms, bool match_case);
+    int                         find(const char* in, int in_len, int start) const;
+    bool                        match_case() const
+                                    { return _match_case; }
+    size_t                      size() const
+                                    { return _terms.size(); }
+    const std::vector<std::string>& terms() const
+                                    { return _terms; }
+    static std::vector<std::string> Split(const std::string& find);
+private:
+    bool                        _match_case;
+    int                         _class[256];
+    int                         _width;
+    std::vector<int>            _next;
+    std::vector<int>            _out;
+    std::vector<std::string>    _terms;
+};
+class ResultStore {
+public:
+    enum class KIND : uint8_t {
+                                MESSAGE,
+                                MATCH,
+                                OUTPUT,
+    };
+    static constexpr uint32_t   NO_FILE = 0xffff'ffff;
+    void                        add(const std::string& message)
+                                    { _add(KIND::MESSAGE, NO_FILE, 0, 0, message.c_str(), message.length()); }
+    void                        add(const std::string& filename, int line, int col, const char* text, size_t len)
+                                    { _add(KIND::MATCH, (filename != "") ? _file_id(filename) : NO_FILE, line, col, text, len); }
+    void                        add_output(const std::string& text, const std::string& filename = "", int line = 0, int col = 0)
+                                    { _add(KIND::OUTPUT, (filename != "") ? _file_id(filename) : NO_FILE, line, col, text.c_str(), text.length()); }
+    void                        append(const ResultStore& other, size_t rows = SIZE_MAX);
+    void                        clear();
+    int                         col(size_t row) const
+                                    { return _col[row]; }
+    std::string                 file(size_t row) const
+                                    { return (_file[row] == NO_FILE) ? "" : _files[_file[row]]; }
+    std::string                 format(size_t row) const;
+    bool                        has_location(size_t row) const
+                                    { return _line[row] > 0; }
+    KIND                        kind(size_t row) const
+                                    { return _kind[row]; }
+    int                         line(size_t row) const
+                                    { return _line[row]; }
+    size_t                      size() const
+                                    { return _kind.size(); }
+    void                        swap(ResultStore& other);
+    const char*                 text(size_t row) const
+                                    { return _text.c_str() + _offset[row]; }
+private:
+    void                        _add(KIND kind, uint32_t file, int line, int col, const char* text, size_t len);
+    uint32_t                    _file_id(const std::string& filename);
+    StringIntHash               _ids;
+    std::string                 _text;
+    std::vector<KIND>           _kind;
+    std::vector<int>            _col;
+    std::vector<int>            _line;
+    std::vector<size_t>         _offset;
+    std::vector<std::string>    _files;
+    std::vector<uint32_t>       _file;
+};
 struct StatusBarInfo {
     int                         col;
     int                         end;
@@ -2557,6 +2774,45 @@ public:
 private:
     uint16_t                    _char[256];
 };
+class WordScanner {
+public:
+    explicit                    WordScanner(const char* text, size_t len, bool simd = true);
+    bool                        is_simd() const
+                                    { return _simd; }
+    bool                        next(const char*& word, size_t& len);
+    static std::string          Benchmark(const char* text, size_t len);
+private:
+    uint64_t                    _letters(size_t pos) const;
+    const char*                 _text;
+    bool                        _simd;
+    size_t                      _block;
+    size_t                      _len;
+    uint64_t                    _bits;
+    uint8_t                     _hi[16];
+    uint8_t                     _lo[16];
+    uint8_t                     _table[256];
+};
+class WordTable {
+public:
+    struct Span {
+        const char*             word;
+        uint64_t                hash;
+        uint32_t                len;
+        uint32_t                count;
+    };
+    explicit                    WordTable(size_t reserve = 1'024);
+    bool                        add(const char* word, size_t len, bool insert = true);
+    void                        release();
+    size_t                      size() const
+                                    { return _spans.size(); }
+    const std::vector<Span>&    spans() const
+                                    { return _spans; }
+    static uint64_t             Hash(const char* word, size_t len);
+private:
+    void                        _grow();
+    std::vector<Span>           _spans;
+    std::vector<uint32_t>       _slots;
+};
 }
 #include <cassert>
 #include <FL/Fl_Text_Display.H>
@@ -2704,7 +2960,93 @@ class StyleTS : public StyleJS {
 public:
                                 StyleTS();
 };
+class WordIndex {
+public:
+    struct Entry {
+        unsigned                refs;
+        unsigned                slot;
+    };
+    struct Head {
+        uint32_t                slot;
+        uint8_t                 length;
+        uint8_t                 at;
+        char                    text[18];
+    };
+    struct Bucket {
+        std::vector<uint64_t>   keys;
+        std::vector<Head>       heads;
+    };
+    typedef std::unordered_map<std::string, Entry> Pool;
+    struct Slot {
+        Pool::value_type*       word;
+        uint32_t                offset;
+        uint32_t                length;
+    };
+    static constexpr unsigned   FIXED        = 0x8000'0000;
+    static constexpr size_t     LENGTHS      = 16;
+    static constexpr int        LOCAL        = 0x0100'0000;
+    static constexpr size_t     MAX_COMPLETE = 500;
+    static constexpr unsigned   NONE         = UINT_MAX;
+    static constexpr int        PROXIMITY    = 2'048;
+    static constexpr int        REBUILD      = 65'536;
+    static Bucket               BUCKETS[32 * 2 * 16];
+    static size_t               GARBAGE;
+    static std::vector<WordIndex*> INDEXES;
+    static std::vector<uint64_t> KEYS;
+    static Pool                 POOL;
+    static std::vector<Slot>    SLOTS;
+    static std::string          TEXT;
+                                WordIndex(const WordIndex&) = delete;
+                                WordIndex(WordIndex&&) = delete;
+    WordIndex&                  operator=(const WordIndex&) = delete;
+    WordIndex&                  operator=(WordIndex&&) = delete;
+                                WordIndex();
+                                ~WordIndex();
+    void                        build(char* text, size_t len);
+    void                        cancel();
+    void                        clear();
+    void                        clear_fixed();
+    size_t                      complete(const std::string& query, const TextBuffer& buffer, int pos, std::vector<std::string>& out) const;
+    void                        insert(const StringSet& words);
+    bool                        is_active() const
+                                    { return _active; }
+    bool                        is_building() const
+                                    { return _text != nullptr; }
+    bool                        publish();
+    size_t                      size() const
+                                    { return _size; }
+    void                        update(TextBuffer& buffer, int pos, int inserted_size, int deleted_size, const char* deleted_text);
+    static uint64_t             Key(const char* word, size_t len, bool query = false);
+    static int                  Score(const char* query, size_t query_len, const char* word, size_t word_len);
+private:
+    static void                 _Compact();
+    unsigned                    _find(std::string_view word) const;
+    static int                  _Bonus(unsigned count);
+    static size_t               _Bucket(unsigned bit, size_t at, size_t length)
+                                    { return (bit * 2 + ((at > 0) ? 1 : 0)) * WordIndex::LENGTHS + std::min(length / 4, WordIndex::LENGTHS - 1); }
+    static void                 _Heads(unsigned slot, std::string_view word, uint64_t key);
+    void                        _release(unsigned slot);
+    void                        _reset();
+    unsigned                    _retain(std::string_view word);
+    void                        _scan(const char* text, size_t len, int delta);
+    static void                 ThreadFunc(WordIndex* self);
+    std::vector<unsigned>       _count;
+    WordTable                   _built;
+    std::vector<std::pair<std::string, std::string>> _journal;
+    Token                       _tokens;
+    bool                        _active;
+    char*                       _text;
+    int                         _limit;
+    int64_t                     _time;
+    size_t                      _length;
+    size_t                      _size;
+    unsigned                    _peak;
+    std::atomic<bool>           _cancel;
+    std::atomic<bool>           _done;
+    std::thread                 _thread;
+};
 }
+#include <future>
 namespace fle {
 namespace undo {
 enum class EVENT : uint8_t {
@@ -2716,6 +3058,7 @@ enum class EVENT : uint8_t {
                                 SELECTED  =  16,
                                 CUSTOM1   =  32,
                                 CUSTOM2   =  64,
+                                DIFF      = 128,
 };
 enum class STATUS : unsigned {
                                 INIT,
@@ -2730,6 +3073,8 @@ public:
                                     { _flag = static_cast<uint8_t>(EVENT::NIL); _group = 0; _pos = 0; }
                                 Event(uint8_t flag, uint16_t group, int pos, const char* str1, const char* str2 = "") : _str1(str1), _str2(str2 ? str2 : "")
                                     { _flag = flag; _group = group; _pos = pos; }
+                                Event(uint8_t flag, uint16_t group, int pos, const char* str1, size_t len1, const char* str2, size_t len2) : _str1(str1, len1), _str2(str2, len2)
+                                    { _flag = flag; _group = group; _pos = pos; }
     void                        append_str1(const char* in)
                                     { _str1 += in; }
     void                        append_str2(const char* in)
@@ -2755,6 +3100,8 @@ public:
                                     { return _flag & static_cast<uint8_t>(EVENT::CUSTOM2); }
     bool                        is_delete() const
                                     { return _flag & static_cast<uint8_t>(EVENT::ERASED); }
+    bool                        is_diff() const
+                                    { return _flag & static_cast<uint8_t>(EVENT::DIFF); }
     bool                        is_insert() const
                                     { return _flag & static_cast<uint8_t>(EVENT::INSERT); }
     bool                        is_nil() const
@@ -2774,7 +3121,7 @@ public:
     void                        pos(int32_t pos)
                                     { _pos = pos; }
     uint32_t                    size() const
-                                    { return static_cast<uint32_t>(Event::NumberSize() + _str1.length() + 1 + _str2.length() + 1); }
+                                    { return static_cast<uint32_t>(Event::NumberSize() + sizeof(uint32_t) + _str1.length() + sizeof(uint32_t) + _str2.length()); }
     std::string                 str1() const
                                     { return _str1; }
     void                        str1(const char* in)
@@ -2787,6 +3134,7 @@ public:
                                     { _str2 = in; }
     int                         str2_toint(int r[3]) const
                                     { return string::toints(_str2, r, 3); }
+    void                        write(char* out) const;
     static inline uint32_t      NumberSize()
                                     { return static_cast<uint32_t>(sizeof(_flag) + sizeof(_group) + sizeof(_pos)); }
 private:
@@ -2797,6 +3145,48 @@ private:
     std::string                 _str1;
     std::string                 _str2;
 };
+class EventView {
+public:
+                                EventView()
+                                    { _flag = static_cast<uint8_t>(EVENT::NIL); _group = 0; _pos = 0; _len1 = 0; _len2 = 0; _str1 = ""; _str2 = ""; }
+    explicit                    EventView(const char* in);
+                                EventView(const Event& event)
+                                    { _flag = event.flag(); _group = event.group(); _pos = event.pos(); _len1 = event.len1(); _len2 = event.len2(); _str1 = event.c_str1(); _str2 = event.c_str2(); }
+    Event                       event() const
+                                    { return (is_null() == true) ? Event() : Event(_flag, _group, _pos, _str1, _len1, _str2, _len2); }
+    uint8_t                     flag() const
+                                    { return _flag; }
+    uint16_t                    group() const
+                                    { return _group; }
+    bool                        is_delete() const
+                                    { return _flag & static_cast<uint8_t>(EVENT::ERASED); }
+    bool                        is_insert() const
+                                    { return _flag & static_cast<uint8_t>(EVENT::INSERT); }
+    bool                        is_null() const
+                                    { return _len1 == 0; }
+    bool                        is_replace() const
+                                    { return _flag & static_cast<uint8_t>(EVENT::REPLACE); }
+    int                         len1() const
+                                    { return static_cast<int>(_len1); }
+    int                         len2() const
+                                    { return static_cast<int>(_len2); }
+    int32_t                     pos() const
+                                    { return _pos; }
+    uint32_t                    size() const
+                                    { return static_cast<uint32_t>(Event::NumberSize() + sizeof(uint32_t) + _len1 + sizeof(uint32_t) + _len2); }
+    const char*                 str1() const
+                                    { return _str1; }
+    const char*                 str2() const
+                                    { return _str2; }
+private:
+    const char*                 _str1;
+    const char*                 _str2;
+    int32_t                     _pos;
+    uint16_t                    _group;
+    uint32_t                    _len1;
+    uint32_t                    _len2;
+    uint8_t                     _flag;
+};
 class Store {
     friend class Undo;
 public:
@@ -2804,10 +3194,12 @@ public:
                                 Store(Store&&) = delete;
     Store&                      operator=(const Store&) = delete;
     Store&                      operator=(Store&&) = delete;
+    static constexpr int        FORMAT = 2;
                                 Store()
                                     { ; }
     virtual                     ~Store()
                                     { ; }
+    virtual bool                append_last(uint8_t flag, int32_t pos, bool second, bool front, const char* in, size_t len) = 0;
     virtual ssize_t             capacity() const = 0;
     virtual void                clear() = 0;
     virtual ssize_t             cursor() const = 0;
@@ -2823,9 +3215,12 @@ public:
     virtual bool                has_right() const = 0;
     virtual void                invalidate_group_counter_at_cursor() = 0;
     virtual bool                is_cursor_at_end() const = 0;
-    virtual const Event         peek_left() const = 0;
-    virtual const Event         peek_right() const = 0;
+    virtual const EventView     peek_left() const = 0;
+    virtual const EventView     peek_right() const = 0;
     virtual void                pop() = 0;
+    virtual ssize_t             raw_capacity() const
+                                    { return capacity(); }
+    virtual void                seek(ssize_t cursor) = 0;
     virtual void                set_node(const Event& node) = 0;
     virtual ssize_t             size() const = 0;
 protected:
@@ -2835,6 +3230,88 @@ protected:
                                 RIGHT = 1,
     };
 };
+class BlockStore : public Store {
+    friend class Undo;
+public:
+    struct Block {
+        bool                    packed;
+        int64_t                 offset;
+        size_t                  size;
+        ssize_t                 end;
+        ssize_t                 start;
+        uint64_t                hash;
+        std::string             data;
+        std::future<std::string> pending;
+    };
+    static constexpr ssize_t    BLOCK_SIZE = 262'144;
+    static size_t               MEMORY;
+                                BlockStore(const BlockStore&) = delete;
+                                BlockStore(BlockStore&&) = delete;
+    BlockStore&                 operator=(const BlockStore&) = delete;
+    BlockStore&                 operator=(BlockStore&&) = delete;
+                                BlockStore()
+                                    { _file = nullptr; _memory = 0; BlockStore::STORES.push_back(this); clear(); }
+                                ~BlockStore();
+    bool                        append_last(uint8_t flag, int32_t pos, bool second, bool front, const char* in, size_t len) override;
+    std::string                 block_data(size_t index) const;
+    const std::vector<Block>&   blocks();
+    ssize_t                     capacity() const override;
+    void                        clear() override;
+    ssize_t                     cursor() const override
+                                    { auto left = _bcur; go_left(left); return (_move < MOVE::RIGHT) ? left : _bcur; }
+    ssize_t                     debug(bool all = false) const override;
+    const Event                 get_node() const override
+                                    { return get_node(_bcur); }
+    const Event                 get_node(ssize_t cursor) const override;
+    bool                        go_left() override;
+    bool                        go_left(ssize_t& cursor) const override;
+    bool                        go_right() override;
+    bool                        go_right(ssize_t& cursor) const override;
+    void                        go_right_before_cut() override;
+    bool                        has_left() const override
+                                    { auto test = _bcur; go_left(test); return _move == MOVE::RIGHT || test >= 0; }
+    bool                        has_right() const override
+                                    { auto test = _bcur; go_right(test); return _move == MOVE::LEFT || test < _bend; }
+    const std::string&          hot() const
+                                    { return _hot; }
+    void                        invalidate_group_counter_at_cursor() override;
+    bool                        is_cursor_at_end() const override
+                                    { return _bcur == _bend; }
+    const EventView             peek_left() const override;
+    const EventView             peek_right() const override;
+    void                        pop() override;
+    ssize_t                     raw_capacity() const override;
+    bool                        restore(std::vector<Block>& blocks, const std::string& hot, ssize_t cursor);
+    void                        seek(ssize_t cursor) override;
+    void                        set_node(const Event& node) override;
+    ssize_t                     size() const override
+                                    { return _bcur; }
+    static std::string          Compress(const char* in, size_t in_len);
+    static bool                 Decompress(const char* in, size_t in_len, std::string& out, size_t out_len);
+private:
+    size_t                      _block(ssize_t pos) const;
+    void                        _close();
+    bool                        _pack(Block& block, bool wait);
+    const char*                 _ptr(ssize_t pos) const;
+    bool                        _read(const Block& block, std::string& out) const;
+    void                        _seal();
+    bool                        _seek(int64_t pos) const;
+    void                        _spill(size_t budget);
+    void                        _truncate(ssize_t pos);
+    static std::vector<BlockStore*> STORES;
+    FILE*                       _file;
+    MOVE                        _move;
+    int64_t                     _file_end;
+    mutable ssize_t             _cache_block;
+    mutable std::string         _cache;
+    size_t                      _memory;
+    ssize_t                     _bcur;
+    ssize_t                     _bend;
+    ssize_t                     _hot_start;
+    std::string                 _filename;
+    std::string                 _hot;
+    std::vector<Block>          _blocks;
+};
 class BufferStore : public Store {
     friend class Undo;
 public:
@@ -2846,6 +3323,7 @@ public:
                                     { _buf = nullptr; clear(); }
                                 ~BufferStore()
                                     { free(_buf); }
+    bool                        append_last(uint8_t flag, int32_t pos, bool second, bool front, const char* in, size_t len) override;
     ssize_t                     capacity() const override
                                     { return _bcap; }
     void                        clear() override;
@@ -2867,9 +3345,10 @@ public:
     void                        invalidate_group_counter_at_cursor() override;
     bool                        is_cursor_at_end() const override
                                     { return _bcur == _bend; }
-    const Event                 peek_left() const override;
-    const Event                 peek_right() const override;
+    const EventView             peek_left() const override;
+    const EventView             peek_right() const override;
     void                        pop() override;
+    void                        seek(ssize_t cursor) override;
     void                        set_node(const Event& node) override;
     ssize_t                     size() const override
                                     { return _bcur; }
@@ -2891,6 +3370,7 @@ public:
     VectorStore&                operator=(VectorStore&&) = delete;
                                 VectorStore()
                                     { clear(); }
+    bool                        append_last(uint8_t flag, int32_t pos, bool second, bool front, const char* in, size_t len) override;
     ssize_t                     capacity() const override;
     void                        clear() override;
     ssize_t                     cursor() const override
@@ -2911,9 +3391,10 @@ public:
     void                        invalidate_group_counter_at_cursor() override;
     bool                        is_cursor_at_end() const override
                                     { return _cur == static_cast<ssize_t>(_events.size()); }
-    const Event                 peek_left() const override;
-    const Event                 peek_right() const override;
+    const EventView             peek_left() const override;
+    const EventView             peek_right() const override;
     void                        pop() override;
+    void                        seek(ssize_t cursor) override;
     void                        set_node(const Event& node) override;
     ssize_t                     size() const override
                                     { return _cur; }
@@ -2928,16 +3409,18 @@ public:
                                 Undo(Undo&&) = delete;
     Undo&                       operator=(const Undo&) = delete;
     Undo&                       operator=(Undo&&) = delete;
+    static constexpr ssize_t    SAVE_POINT_NONE = -2;
+    static constexpr size_t     SNAPSHOT_EVENTS = 5'000;
+    static constexpr size_t     SNAPSHOT_MAX    = 8;
                                 Undo(Store* store, FUndoModeFle fundoappend = FUndoModeFle::TYPE, size_t break_at = 21, double break_time = 1.0);
-    virtual                     ~Undo()
-                                    { delete _store; }
+    virtual                     ~Undo();
     [[nodiscard]] virtual STATUS add(FDelKey delkey, bool selection, int pos, const char* inserted_text, const int inserted_size, const char* deleted_text = nullptr, const int deleted_size = 0);
     void                        add_custom1(std::string str1)
                                     { auto custom = Event(static_cast<uint8_t>(EVENT::CUSTOM1), _group, -1, str1.c_str()); _push_node_to_buf(custom); }
+    STATUS                      add_diff(int offset, const char* before, size_t before_len, const char* after, size_t after_len);
     void                        break_append()
                                     { _break = (_fundoappend == FUndoModeFle::TYPE) ? 1 : 2; }
-    ssize_t                     capacity() const
-                                    { return _store->capacity(); }
+    ssize_t                     capacity() const;
     virtual void                clear();
     void                        clear_custom1()
                                     { _custom1 = Event(); }
@@ -2960,27 +3443,56 @@ public:
                                     { return _save_point > _store->cursor(); }
     bool                        is_group_locked() const
                                     { return _group_lock; }
-    Event                       peek_redo() const
+    EventView                   peek_redo() const
                                     { return _store->peek_right(); }
-    Event                       peek_undo() const
+    EventView                   peek_undo() const
                                     { return _store->peek_left(); }
     void                        prepare_custom1(std::string str1)
                                     { _custom1 = Event(static_cast<uint8_t>(EVENT::CUSTOM1), _group, -1, str1.c_str()); }
     void                        prepare_custom2(const char* str2)
                                     { _custom2 = str2; }
+    ssize_t                     raw_capacity() const;
+    void                        restore_save_point();
     Event                       redo()
                                     { _prev_type = Token::NIL; return (_store->go_right() == true) ? _store->get_node() : Event(); }
+    ssize_t                     save_point() const
+                                    { return _save_point; }
     void                        set_save_point();
     ssize_t                     size() const
                                     { return _store->size(); }
+    void                        snapshot_add(char* text, size_t length);
+    bool                        snapshot_due() const
+                                    { return _snapshot_events >= Undo::SNAPSHOT_EVENTS && _group_lock == false; }
+    bool                        snapshot_exists() const
+                                    { return _snapshots.find(_store->cursor()) != _snapshots.end(); }
+    int                         snapshot_jump(ssize_t target, bool undo, std::string& text);
+    Store*                      store()
+                                    { return _store; }
     Event                       undo()
                                     { _prev_type = Token::NIL; return (_store->go_left() == true) ? _store->get_node() : Event(); }
+    static std::string          Benchmark(Store* store, const std::string& name, int count = 1'000'000);
+    static bool                 Diff(const char* before, size_t before_len, const char* after, size_t after_len, int& pos, std::string& str1, std::string& str2);
+    static bool                 DiffApply(const Event& node, bool undo, const char* in, size_t in_len, std::string& out);
+    static ssize_t              DiffSize(const Event& node, bool undo);
+    static void                 SnapshotEvict();
 protected:
-    STATUS                      _add(Event* last, uint8_t flag, int pos, const char* str1, const char* str2 = "");
-    STATUS                      _append_to_node(Event* last, uint8_t flag, int pos, const char* str);
+    static const char*          _DiffHeader(const char* in, size_t num[3]);
+    static size_t               _DiffHunk(size_t gap, const char* before, const char* before_end, const char* after, const char* after_end, std::string& str1, std::string& str2);
+    STATUS                      _add(EventView* last, uint8_t flag, int pos, const char* str1, size_t len1, const char* str2 = "", size_t len2 = 0);
+    STATUS                      _append_to_node(EventView* last, uint8_t flag, int pos, const char* str, size_t len);
     bool                        _is_cursor_at_end() const
                                     { return _store->is_cursor_at_end(); }
     void                        _push_node_to_buf(Event node);
+    struct Snapshot {
+        size_t                  length;
+        size_t                  size;
+        std::string             data;
+        std::future<std::string> pending;
+    };
+    void                        _snapshot_cut(ssize_t cursor);
+    std::map<ssize_t, Snapshot>::iterator _snapshot_erase(std::map<ssize_t, Snapshot>::iterator it);
+    bool                        _snapshot_ready(Snapshot& snapshot, bool wait);
+    static std::vector<Undo*>   UNDOS;
     Event                       _custom1;
     FUndoModeFle              _fundoappend;
     Store*                      _store;
@@ -2990,7 +3502,9 @@ protected:
     double                      _time;
     int                         _break;
     size_t                      _break_at;
+    size_t                      _snapshot_events;
     ssize_t                     _save_point;
+    std::map<ssize_t, Snapshot> _snapshots;
     std::string                 _custom2;
     uint16_t                    _group;
     uint16_t                    _prev_type;
@@ -2999,6 +3513,7 @@ protected:
 }
 }
 #include <FL/Fl_Text_Buffer.H>
+#include <atomic>
 namespace fle {
 class Editor;
 struct CursorPos;
@@ -3009,20 +3524,28 @@ public:
                                 BufferController(BufferController&&) = delete;
     BufferController&           operator=(const BufferController&) = delete;
     BufferController&           operator=(BufferController&&) = delete;
-                                BufferController(TextBuffer* buffer, int timeout, bool start_group_lock);
+                                BufferController(TextBuffer* buffer, int timeout, bool start_group_lock, const std::string& progress = "");
                                 ~BufferController()
                                     { stop(); }
-    void                        check_timeout();
+    bool                        cancelled() const
+                                    { return _cancelled; }
+    bool                        check_timeout(int pos = 0);
+    CursorPos                   rollback(CursorPos cursor);
     void                        stop();
     int                         time() const
                                     { return _time; }
+    static constexpr unsigned   POLL = 256;
 private:
     TextBuffer*                 _buffer;
+    bool                        _cancelled;
     bool                        _running;
     bool                        _stopped;
     flw::WaitCursor*            _wc;
+    flw::dlg::Progress*         _progress;
     int64_t                     _time;
     int64_t                     _timeout;
+    std::string                 _label;
+    unsigned                    _polls;
 };
 class TextBuffer : public Fl_Text_Buffer {
     friend class BufferController;
@@ -3039,6 +3562,8 @@ public:
     unsigned char               operator[](unsigned pos) const
                                     { return peek(pos); }
     void                        break_undo_append();
+    bool                        cancelled() const
+                                    { return _cancelled; }
     void                        callback_connect()
                                     { add_modify_callback(TextBuffer::CallbackUndo, this); }
     void                        callback_disconnect()
@@ -3065,13 +3590,14 @@ public:
     int                         delete_text_left(int pos, FDelText del);
     int                         delete_text_right(int pos, FDelText del);
     CursorPos                   duplicate_text();
+    std::string                 edit_benchmark(Style* style);
     Editor*                     editor()
                                     { return _editor; }
-    size_t                      find_lines(std::string filename, std::string find, gnu::pcre8::PCRE* re, FTrim ftrim, std::vector<std::string>& out);
-    CursorPos                   find_replace(std::string find, const char* replace, FSearchDir fsearchdir, FCaseCompare fcasecompare, FWordCompare fwordcompare, FNlTab fnltab);
-    CursorPos                   find_replace_all(std::string find, std::string replace, FSelection fselection, FCaseCompare fcase, FWordCompare fword, FNlTab fnltab);
-    CursorPos                   find_replace_regex(const std::string& find, const char* replace, FNlTab fnltab);
-    CursorPos                   find_replace_regex_all(gnu::pcre8::PCRE* regex, std::string replace, FSelection fselection, FNlTab fnltab);
+    size_t                      find_lines(std::string filename, std::string find, gnu::pcre8::PCRE* re, const MultiSearch* terms, FScope fscope, FTrim ftrim, ResultStore& out);
+    CursorPos                   find_replace(std::string find, const char* replace, FSearchDir fsearchdir, FCaseCompare fcasecompare, FWordCompare fwordcompare, FNlTab fnltab, FScope fscope);
+    CursorPos                   find_replace_all(std::string find, std::string replace, FSelection fselection, FCaseCompare fcase, FWordCompare fword, FNlTab fnltab, FScope fscope);
+    CursorPos                   find_replace_regex(const std::string& find, const char* replace, FNlTab fnltab, FScope fscope);
+    CursorPos                   find_replace_regex_all(gnu::pcre8::PCRE* regex, std::string replace, FSelection fselection, FNlTab fnltab, FScope fscope);
     gnu::file::Buf              get(FLineEnding flineending, FTrim ftrim, FChecksum fchecksum);
     std::string                 get_first(int pos) const;
     std::string                 get_indent(int pos) const;
@@ -3091,6 +3617,7 @@ public:
     bool                        has_multiline_selection();
     bool                        has_restyle() const
                                     { return _style_text; }
+    bool                        has_scope_style(FScope fscope) const;
     bool                        has_selection()
                                     { return _has_selection == true || selected() != 0; }
     int                         home(int pos);
@@ -3103,7 +3630,12 @@ public:
     CursorPos                   move_lines_up_or_down(FMoveV move);
     CursorPos                   move_text_left_or_right(CursorPos pos, FMoveH fmoveh, FTab ftab, unsigned tab_width);
     CursorPos                   redo(FUndoRange fundocount, CursorPos cursor);
+    size_t                      revision() const
+                                    { return _revision; }
     CursorPos                   sort(FSort order);
+    CursorPos                   swap_text(const std::string& text);
+    std::string                 search_benchmark(const std::string& find, bool match_case) const;
+    bool                        search_literal(const LiteralSearch& search, int start, FSearchDir fsearchdir, int& found) const;
     CursorPos                   select_color();
     CursorPos                   select_line(bool exclude_newline);
     CursorPos                   select_pair(bool move_cursor, bool& found);
@@ -3114,8 +3646,7 @@ public:
     void                        set_delete_key()
                                     { _fdelkey = FDelKey::DEL; }
     void                        set_dirty(bool value, bool force_send = false);
-    void                        set_save_point()
-                                    { if (_undo != nullptr) { _undo->set_save_point(); _undo->break_append(); } }
+    void                        set_save_point(char* text = nullptr);
     undo::Undo*                 undo()
                                     { return _undo; }
     CursorPos                   undo(FUndoRange fundocount, CursorPos cursor);
@@ -3177,6 +3708,22 @@ public:
                                     }
                                     return 0;
                                 }
+    inline void                 peek(unsigned start, unsigned end, char* out) const {
+                                    if (end > (unsigned) mLength || start >= end) {
+                                        return;
+                                    }
+                                    else if (end <= (unsigned) mGapStart) {
+                                        memcpy(out, mBuf + start, end - start);
+                                    }
+                                    else if (start >= (unsigned) mGapStart) {
+                                        memcpy(out, mBuf + start + mGapEnd - mGapStart, end - start);
+                                    }
+                                    else {
+                                        auto len1 = mGapStart - start;
+                                        memcpy(out, mBuf + start, len1);
+                                        memcpy(out + len1, mBuf + mGapEnd, end - start - len1);
+                                    }
+                                }
     inline void                 poke(unsigned pos, char c) {
                                     if (pos < (unsigned) mGapStart) {
                                         *(mBuf + pos) = c;
@@ -3204,36 +3751,60 @@ public:
                                     }
                                 }
     static void                 CallbackUndo(const int pos, const int inserted_size, const int deleted_size, const int restyled_size, const char* deleted_text, void* v);
+    static int                  FindAll(const char* text, int text_len, const char* style, int from, int to, const std::string& find, FCaseCompare fcase, FWordCompare fword, FScope fscope, std::vector<int>& out, const std::atomic<bool>* cancel = nullptr);
+    static size_t               FindLines(const std::string& filename, const char* text, int text_len, const std::string& find, const gnu::pcre8::PCRE* re, const MultiSearch* terms, const char* style, FScope fscope, FTrim ftrim, ResultStore& out, const std::atomic<bool>* cancel = nullptr);
+    static bool                 InScope(char style, FScope fscope);
+    static int                  ReplaceAll(const char* text, int text_len, const char* style, std::string find, std::string replace, FRegex fregex, FCaseCompare fcase, FWordCompare fword, FNlTab fnltab, FScope fscope, std::string& out, const std::atomic<bool>* cancel = nullptr);
 #ifdef DEBUG
-    CursorPos                   _find_replace_regex_all(gnu::pcre8::PCRE* regex, const std::string replace, int from, int to, FRegexType fregextype, FSelection fselection, bool last = false);
+    CursorPos                   _find_replace_regex_all(gnu::pcre8::PCRE* regex, const std::string replace, int from, int to, FRegexType fregextype, FSelection fselection, FScope fscope, bool last = false);
 #endif
 private:
+    const char*                 _contiguous()
+                                    { move_gap(mLength); return mBuf; }
 #ifndef DEBUG
-    CursorPos                   _find_replace_regex_all(gnu::pcre8::PCRE* regex, const std::string replace, int from, int to, FRegexType fregextype, FSelection fselection, bool last = false);
+    CursorPos                   _find_replace_regex_all(gnu::pcre8::PCRE* regex, const std::string replace, int from, int to, FRegexType fregextype, FSelection fselection, FScope fscope, bool last = false);
 #endif
+    bool                        _in_scope(int pos, FScope fscope) const;
     bool                        _is_word(int start, int end, Token::Type word_type);
     Token::Type                 _peek_token(int pos) const
                                     { return _word.get(peek(pos)); }
+    bool                        _scope_style(FScope fscope, const char*& style);
+    bool                        _swap_text(const std::string& text, CursorPos& cursor);
     Token::Type                 _token(unsigned char c) const
                                     { return _word.get(c); }
     Token::Type                 _token(const std::string& string) const;
+    void                        _undo_diff(const undo::Event& node, bool undo, CursorPos& cursor);
+    void                        _undo_diff_begin();
+    void                        _undo_diff_end();
+    void                        _undo_diff_track(int pos, int inserted_size, int deleted_size, const char* deleted_text);
+    int                         _undo_jump(ssize_t target, bool undo, CursorPos& cursor);
+    void                        _undo_snapshot(char* text = nullptr);
+    static bool                 AddFoundLine(const std::string& filename, int row, int col, const char* line, int len, FTrim ftrim, ResultStore& out);
     Config&                     _config;
     Editor*                     _editor;
     FDelKey                     _fdelkey;
     FUndoMode                   _fundo;
     Token                       _word;
     undo::Undo*                 _undo;
+    bool                        _cancelled;
     bool                        _dirty;
     bool                        _has_selection;
     bool                        _pause_undo;
     bool                        _style_text;
+    bool                        _track_diff;
     char                        _buf[256];
     int                         _count_changes;
+    int                         _diff_end;
+    int                         _diff_start;
     int                         _hack_undo;
+    size_t                      _revision;
     std::string                 _checksum;
+    std::string                 _diff;
 };
 }
+#include <FL/Fl_Browser_.H>
 #include <FL/Fl_Check_Button.H>
+#include <FL/Fl_Choice.H>
 #include <FL/Fl_Int_Input.H>
 namespace fle {
 class Editor;
@@ -3244,6 +3815,7 @@ public:
                                     { return _event; }
     int                         handle(int event) override;
     int                         populate(Fl_Fontsize fontsize, const std::set<std::string>& words, const std::string& word, int word_pos);
+    int                         populate(Fl_Fontsize fontsize, const WordIndex& words, const TextBuffer& buffer, const std::string& word, int word_pos);
     void                        popup(int X, int Y, int W, int H);
     std::string                 selected() const;
     std::string                 word() const
@@ -3258,7 +3830,10 @@ private:
 };
 class FindDialog : public Fl_Double_Window {
 public:
+    static FCaseCompare         CASE;
     static FRegex               REGEX;
+    static FScope               SCOPE;
+    static FTerms               TERMS;
     static FTrim                TRIM;
                                 FindDialog(const std::string& label, const std::vector<std::string>& find_list);
     std::string                 run();
@@ -3269,8 +3844,11 @@ private:
     Fl_Button*                  _help;
     Fl_Button*                  _ok;
     Fl_Button*                  _test;
+    Fl_Check_Button*            _case;
     Fl_Check_Button*            _regex;
+    Fl_Check_Button*            _terms;
     Fl_Check_Button*            _trim;
+    Fl_Choice*                  _scope;
     bool                        _ret;
     bool                        _run;
     flw::GridGroup*             _grid;
@@ -3299,6 +3877,10 @@ public:
                                     { return (_regex->value() != 0) ? FRegex::YES : FRegex::NO; }
     void                        fregex(FRegex value)
                                     { _regex->value((value == FRegex::NO) ? 0 : 1); }
+    FScope                      fscope() const
+                                    { return static_cast<FScope>(_scope->value()); }
+    void                        fscope(FScope value)
+                                    { _scope->value(static_cast<int>(value)); }
     FSelection                  fselection() const
                                     { return (_selection->value() != 0) ? FSelection::YES : FSelection::NO; }
     void                        fselection(FSelection value)
@@ -3342,6 +3924,7 @@ private:
     Fl_Check_Button*            _replace_nl;
     Fl_Check_Button*            _selection;
     Fl_Check_Button*            _word;
+    Fl_Choice*                  _scope;
     flw::InputMenu*             _find_input;
     flw::InputMenu*             _replace_input;
 };
@@ -3358,6 +3941,7 @@ public:
     static FCaseCompare         CASECOMPARE;
     static FNlTab               NLTAB;
     static FRegex               REGEX;
+    static FScope               SCOPE;
     static FSelection           SELECTION;
     static FWordCompare         WORDCOMPARE;
                                 ReplaceDialog(const std::string& label, std::string& find, std::string& replace, const std::vector<std::string>& find_list, const std::vector<std::string>& replace_list);
@@ -3377,6 +3961,7 @@ private:
     Fl_Check_Button*            _replace_nl;
     Fl_Check_Button*            _selection;
     Fl_Check_Button*            _word;
+    Fl_Choice*                  _scope;
     bool                        _ret;
     bool                        _run;
     flw::GridGroup*             _grid;
@@ -3385,6 +3970,64 @@ private:
     std::string&                _find;
     std::string&                _replace;
 };
+class ResultList : public Fl_Browser_ {
+public:
+                                ResultList();
+    void                        add(const std::string& message)
+                                    { _results.add(message); redraw(); }
+    void                        append(const ResultStore& results)
+                                    { _results.append(results); redraw(); }
+    void                        clear()
+                                    { _results.clear(); _selected = 0; new_list(); redraw(); }
+    int                         handle(int event) override;
+    const ResultStore&          results() const
+                                    { return _results; }
+    int                         size() const
+                                    { return static_cast<int>(_results.size()); }
+    void                        swap(ResultStore& results)
+                                    { _results.swap(results); _selected = 0; new_list(); redraw(); }
+    std::string                 text(int row) const
+                                    { return (row >= 1 && row <= size()) ? _results.format(row - 1) : ""; }
+    void                        update_pref(Fl_Font text_font, Fl_Fontsize text_size);
+    int                         value() const
+                                    { return _selected; }
+    void                        value(int row);
+    static void                 Callback(Fl_Widget*, void* o);
+protected:
+    int                         full_height() const override
+                                    { return size() * item_height(nullptr); }
+    int                         incr_height() const override
+                                    { return item_height(nullptr); }
+    void*                       item_at(int index) const override
+                                    { return (index >= 1 && index <= size()) ? _item(index) : nullptr; }
+    void                        item_draw(void* item, int X, int Y, int W, int H) const override;
+    void*                       item_first() const override
+                                    { return (size() > 0) ? _item(1) : nullptr; }
+    int                         item_height(void*) const override;
+    void*                       item_last() const override
+                                    { return (size() > 0) ? _item(size()) : nullptr; }
+    void*                       item_next(void* item) const override
+                                    { return (_row(item) < size()) ? _item(_row(item) + 1) : nullptr; }
+    void*                       item_prev(void* item) const override
+                                    { return (_row(item) > 1) ? _item(_row(item) - 1) : nullptr; }
+    int                         item_quick_height(void*) const override
+                                    { return item_height(nullptr); }
+    void                        item_select(void* item, int val) override
+                                    { if (val != 0) _selected = _row(item); else if (_row(item) == _selected) _selected = 0; }
+    int                         item_selected(void* item) const override
+                                    { return (_row(item) == _selected) ? 1 : 0; }
+    const char*                 item_text(void* item) const override
+                                    { return _results.text(_row(item) - 1); }
+    int                         item_width(void* item) const override;
+private:
+    static void*                _item(int row)
+                                    { return reinterpret_cast<void*>(static_cast<intptr_t>(row)); }
+    static int                  _row(void* item)
+                                    { return static_cast<int>(reinterpret_cast<intptr_t>(item)); }
+    Fl_Menu_Button*             _menu;
+    ResultStore                 _results;
+    int                         _selected;
+};
 class StatusBar : public flw::GridGroup {
 public:
     explicit                    StatusBar(Config& config);
@@ -3474,6 +4117,7 @@ public:
     static void                 CallbackStyleBuffer(const int pos, const int inserted_size, const int deleted_size, const int restyled_size, const char* deleted_text, void* v);
 private:
     bool                        _handle_dnd();
+    void                        _draw_matches();
     int                         _handle_key();
     bool                        _handle_mousewheel();
     Editor*                     _editor;
@@ -3555,11 +4199,13 @@ public:
                                     { return (text_is_dirty() == true) ? "*" + _file_info.fi.name() + "*": _file_info.fi.name(); }
     void                        filename_set_new(const std::string& filename)
                                     { _file_info.fi = gnu::file::File(filename); text_set_dirty(true); }
-    size_t                      find_lines(const std::string& find, FRegex fregex, FTrim ftrim);
-    size_t                      find_lines(const std::string& find, FRegex fregex, FTrim ftrim, std::vector<std::string>& out);
+    size_t                      find_lines(const std::string& find, FRegex fregex, FTerms fterms, FCaseCompare fcase, FScope fscope, FTrim ftrim);
+    size_t                      find_lines(const std::string& find, FRegex fregex, FTerms fterms, FCaseCompare fcase, FScope fscope, FTrim ftrim, ResultStore& out);
+    void                        find_incremental();
     void                        find_quick();
     bool                        find_replace(FSearchDir fdir, bool replace_text = false);
-    size_t                      find_replace_all(std::string find, std::string replace, FNlTab fnltab, FSelection fselection,  FCaseCompare fcase, FWordCompare fword, FRegex fregex, FSaveWord fsave, FHideFind fhide, bool disable_message = false);
+    size_t                      find_replace_all(std::string find, std::string replace, FNlTab fnltab, FSelection fselection,  FCaseCompare fcase, FWordCompare fword, FRegex fregex, FScope fscope, FSaveWord fsave, FHideFind fhide, bool disable_message = false);
+    size_t                      find_replace_commit(const std::string& text, size_t count);
     FSearchDir                  find_search_dir() const
                                     { return _editor_flags.fsearchdir; }
     FindBar&                    findbar()
@@ -3568,10 +4214,13 @@ public:
                                     { return _findbar->findreplace(); }
     void                        goto_callback();
     void                        goto_show();
+    const MatchIndex&           matches() const
+                                    { return _matches; }
+    void                        matches_pause(bool pause);
     int                         handle(int event) override;
     void                        help() const;
     bool                        home();
-    size_t                      memory_usage(size_t& buffer, size_t& style, size_t& undo) const;
+    size_t                      memory_usage(size_t& buffer, size_t& style, size_t& undo, size_t& undo_raw) const;
     Message::CTRL               message(const std::string& message, const std::string& s1, const std::string& s2, void* p) override;
     int                         redo(FUndoRange fundocount = FUndoRange::ONE);
     void                        resize(int X, int Y, int W, int H) override
@@ -3663,7 +4312,7 @@ public:
     FUndoMode                       undo_mode() const
                                     { return _buf1->undo_mode(); }
     void                        update_after_focus();
-    void                        update_autocomplete(const char* text = nullptr);
+    void                        update_autocomplete();
     void                        update_pref();
     void                        update_statusbar();
     void                        update_textinfo();
@@ -3708,7 +4357,10 @@ private:
     static void                 CallbackCustom(Fl_Widget* sender, void* o);
     static void                 CallbackFind(Fl_Widget* sender, void* o);
     static void                 CallbackGoto(Fl_Widget* sender, void* o);
+    static void                 CallbackIncremental(void* o);
+    static void                 CallbackModify(int pos, int inserted_size, int deleted_size, int restyled_size, const char* deleted_text, void* o);
     static void                 CallbackOutput(Fl_Widget* w, void* o);
+    static void                 CallbackWords(void* o);
     AutoComplete*               _autocomplete;
     AutoComplete*               _custom;
     Bookmarks                   _bookmarks;
@@ -3719,18 +4371,19 @@ private:
     FindBar*                    _findbar;
     Fl_Menu_Button*             _menu;
     GotoLine*                   _goto;
+    IncrementalSearch           _isearch;
+    MatchIndex                  _matches;
+    ResultList*                 _output;
     StatusBarInfo               _statusbar_info;
-    fle::StringSet              _words;
+    WordIndex                   _words;
     Style*                      _style;
     TextBuffer*                 _buf1;
     TextBuffer*                 _buf2;
     View*                       _view1;
     View*                       _view2;
     View*                       _view;
-    flw::ScrollBrowser*         _output;
     flw::SplitGroup*            _editors;
     flw::SplitGroup*            _main;
-    gnu::pcre8::PCRE*           _regex;
     std::string                 _scheme;
 };
 }
@@ -5074,6 +5727,17 @@ MatchVector PCRE::exec_next(const Match& last) {
     auto count  = pcre_exec(static_cast<::pcre*>(_pcre), nullptr, _subject.c_str(), _subject.length(), last.end(), option, _off, SIZE_OFF);
     return _set_matches(count);
 }
+int PCRE::exec_offsets(const char* subject, size_t length, std::vector<int>& offsets, int start) const {
+    if (_pcre == nullptr) {
+        return PCRE_ERROR_NULL;
+    }
+    if (offsets.size() < SIZE_OFF) {
+        offsets.resize(SIZE_OFF);
+    }
+    auto option = (_notbol == true ? PCRE_NOTBOL : 0) | (_noteol == true ? PCRE_NOTEOL : 0) | (_notempty == true ? PCRE_NOTEMPTY : 0);
+    auto size   = static_cast<int>(offsets.size() - offsets.size() % 3);
+    return pcre_exec(static_cast<::pcre*>(_pcre), nullptr, subject, length, start, option, offsets.data(), size);
+}
 size_t PCRE::Find(const std::string& regex, const std::string& subject) {
     return PCRE::Matches(regex, subject).size();
 }
@@ -13173,6 +13837,9 @@ flw::WaitCursor::~WaitCursor() {
     }
 }
 #include <algorithm>
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#endif
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -13222,11 +13889,11 @@ namespace limits {
     const size_t FILE_SIZE_STEP              =     10'000'000;
     size_t       FILE_SIZE_VAL               =  1'000'000'000;
     size_t       FORCE_RESTYLING             =              0;
-    const size_t OUTPUT_LINES_DEF            =        100'000;
-    const size_t OUTPUT_LINES_MAX            =        500'000;
-    const size_t OUTPUT_LINES_MIN            =         50'000;
-    const size_t OUTPUT_LINES_STEP           =         10'000;
-    size_t       OUTPUT_LINES_VAL            =        100'000;
+    const size_t OUTPUT_LINES_DEF            =      1'000'000;
+    const size_t OUTPUT_LINES_MAX            =      5'000'000;
+    const size_t OUTPUT_LINES_MIN            =              0;
+    const size_t OUTPUT_LINES_STEP           =         50'000;
+    size_t       OUTPUT_LINES_VAL            =      1'000'000;
     const size_t OUTPUT_LINE_LENGTH_DEF      =            400;
     const size_t OUTPUT_LINE_LENGTH_MAX      =           2000;
     const size_t OUTPUT_LINE_LENGTH_MIN      =             80;
@@ -13242,6 +13909,16 @@ namespace limits {
     const size_t STYLE_FILESIZE_MIN          =        500'000;
     const size_t STYLE_FILESIZE_STEP         =        500'000;
     size_t       STYLE_FILESIZE_VAL          =     20'000'000;
+    const size_t UNDO_MEMORY_ALL_DEF         =    512'000'000;
+    const size_t UNDO_MEMORY_ALL_MAX         =  2'000'000'000;
+    const size_t UNDO_MEMORY_ALL_MIN         =     16'000'000;
+    const size_t UNDO_MEMORY_ALL_STEP        =     16'000'000;
+    size_t       UNDO_MEMORY_ALL_VAL         =    512'000'000;
+    const size_t UNDO_MEMORY_DEF             =     64'000'000;
+    const size_t UNDO_MEMORY_MAX             =  1'000'000'000;
+    const size_t UNDO_MEMORY_MIN             =      4'000'000;
+    const size_t UNDO_MEMORY_STEP            =      4'000'000;
+    size_t       UNDO_MEMORY_VAL             =     64'000'000;
     const size_t WRAP_LINE_LENGTH_DEF        =          3'000;
     const size_t WRAP_LINE_LENGTH_MAX        =         10'000;
     const size_t WRAP_LINE_LENGTH_MIN        =            100;
@@ -13527,6 +14204,10 @@ std::string help::find_lines() {
     std::string res = R"(Find lines in a file.
 Enter an search string.
 Or an valid regular expression (using pcre syntax).
+Or several terms separated by spaces if "Terms" is checked.
+Every line that contains any of the terms will be found.
+Use "Scope" to only match code, comments or strings.
+Scope needs syntax styling and is ignored for project files.
 
 Find all lines that starts with 'local'.
 ^local.*
@@ -13573,6 +14254,8 @@ std::string help::flags(const Config& config) {
     res += gnu::str::format("%-*s = %14s\n", width, "limits::OUTPUT_LINE_LENGTH", flw::util::format_int(limits::OUTPUT_LINE_LENGTH_VAL, '\'').c_str());
     res += gnu::str::format("%-*s = %14s\n", width, "limits::SCROLL", flw::util::format_int(limits::SCROLL_VAL, '\'').c_str());
     res += gnu::str::format("%-*s = %14s\n", width, "limits::STYLE_FILESIZE", flw::util::format_int(limits::STYLE_FILESIZE_VAL, '\'').c_str());
+    res += gnu::str::format("%-*s = %14s\n", width, "limits::UNDO_MEMORY", flw::util::format_int(limits::UNDO_MEMORY_VAL, '\'').c_str());
+    res += gnu::str::format("%-*s = %14s\n", width, "limits::UNDO_MEMORY_ALL", flw::util::format_int(limits::UNDO_MEMORY_ALL_VAL, '\'').c_str());
     res += gnu::str::format("%-*s = %14s\n", width, "limits::UNDO_WARNING", flw::util::format_int(limits::UNDO_WARNING, '\'').c_str());
     res += gnu::str::format("%-*s = %14s\n", width, "limits::WRAP_LINE_LENGTH", flw::util::format_int(limits::WRAP_LINE_LENGTH_VAL, '\'').c_str());
     res += "\n";
@@ -13708,6 +14391,9 @@ std::string help::replace_text() {
     std::string res = R"(Replace text in all files.
 Enter an search string.
 Or an valid regular expression (using pcre syntax).
+All files are searched at the same time and a list with the number of replacements for every file is shown before anything is changed.
+Every checked file is changed with one undo step.
+Replace in selection changes one file at a time.
 
 )";
     return res;
@@ -13884,91 +14570,674 @@ std::string KeyConf::to_string() const {
     res += KeyConf::KeyDescr(key_u);
     return res;
 }
-Message::Message(Config& config) : _config(config) {
-    _id = 0;
-    _id = _config.add_receiver(this);
+IncrementalSearch::IncrementalSearch() {
+    _cancel        = false;
+    _copied        = 0;
+    _count         = 0;
+    _done          = true;
+    _length        = 0;
+    _line          = 0;
+    _match_case    = false;
+    _nearest_end   = -1;
+    _nearest_start = -1;
+    _origin        = 0;
+    _regex         = false;
+    _taken         = false;
+    _text          = nullptr;
+    _time          = 0;
+    _wrap          = 0;
+}
+IncrementalSearch::~IncrementalSearch() {
+    invalidate();
+}
+void IncrementalSearch::_add(int start, int end) {
+    if (_nearest_start < 0) {
+        _nearest_end   = end;
+        _nearest_start = start;
+    }
+    if (_ranges.size() < MatchIndex::MAX_RANGES) {
+        _ranges.push_back(std::make_pair(start, end));
+    }
+    _count++;
+}
+void IncrementalSearch::cancel() {
+    _cancel = true;
+    if (_thread.joinable() == true) {
+        _thread.join();
+    }
+    _cancel = false;
+}
+bool IncrementalSearch::copy(const TextBuffer& buffer, int max) {
+    if (_text == nullptr || buffer.length() != _length) {
+        return false;
+    }
+    auto head = _length - _line;
+    while (max > 0 && _copied < _length) {
+        auto copied = static_cast<int>(_copied);
+        auto start  = (copied < head) ? _line + copied : copied - head;
+        auto end    = std::min((copied < head) ? _length : _line, start + max);
+        buffer.peek(start, end, _text + start);
+        max     -= end - start;
+        _copied += end - start;
+    }
+    return true;
 }
-Message::~Message() {
-    _config.remove_receiver(this);
+void IncrementalSearch::invalidate() {
+    cancel();
+    free(_text);
+    _copied = 0;
+    _done   = true;
+    _find   = "";
+    _length = 0;
+    _text   = nullptr;
+}
+void IncrementalSearch::_search_literal(const LiteralSearch& search, int from, int to) {
+    auto len = search.length();
+    while (from < to && _cancel == false) {
+        auto chunk = std::min(to, from + IncrementalSearch::CHUNK);
+        auto end   = std::min(_length, chunk + len - 1);
+        if (_wait(from, end) == false) {
+            break;
+        }
+        auto pos = search.find(_text, end, from);
+        if (pos < 0 || pos >= chunk) {
+            from = chunk;
+        }
+        else {
+            _add(pos, pos + len);
+            from = pos + len;
+        }
+    }
 }
-StatusBarInfo::StatusBarInfo() {
-    col   = 0;
-    end   = 0;
-    pos   = 0;
-    row   = 0;
-    rows  = 0;
-    start = 0;
+void IncrementalSearch::_search_regex(const gnu::pcre8::PCRE& rx, int from, int to) {
+    auto pos = std::min(from, _line);
+    auto off = std::vector<int>();
+    while (pos < _length && pos < to && _cancel == false) {
+        auto nl  = (const char*) nullptr;
+        auto eol = pos;
+        while (nl == nullptr && eol < _length) {
+            auto end = std::min(_length, eol + IncrementalSearch::CHUNK);
+            if (_wait(eol, end) == false) {
+                return;
+            }
+            nl  = static_cast<const char*>(memchr(_text + eol, '\n', end - eol));
+            eol = (nl != nullptr) ? static_cast<int>(nl - _text) : end;
+        }
+        auto start = 0;
+        while (_cancel == false && start <= eol - pos && rx.exec_offsets(_text + pos, eol - pos, off, start) > 0) {
+            if (pos + off[0] >= from && pos + off[0] < to) {
+                _add(pos + off[0], pos + off[1]);
+            }
+            start = std::max(off[1], start + 1);
+        }
+        pos = eol + 1;
+    }
+}
+void IncrementalSearch::snapshot(int length, int origin, int line) {
+    invalidate();
+    _length = length;
+    _origin = std::max(std::min(origin, length), 0);
+    _line   = std::max(std::min(line, _origin), 0);
+    _text   = static_cast<char*>(malloc(length + 1));
+    if (_text != nullptr) {
+        _text[length] = 0;
+    }
+}
+bool IncrementalSearch::start(const std::string& find, bool match_case, bool regex) {
+    cancel();
+    _count         = 0;
+    _done          = false;
+    _err           = "";
+    _find          = find;
+    _match_case    = match_case;
+    _nearest_end   = -1;
+    _nearest_start = -1;
+    _regex         = regex;
+    _taken         = false;
+    _time          = gnu::Time::Milli();
+    _wrap          = 0;
+    _ranges.clear();
+    if (_text == nullptr || find == "") {
+        _done = true;
+        return false;
+    }
+    else if (regex == true) {
+        auto rx = gnu::pcre8::PCRE(find, true);
+        if (rx.is_compiled() == false) {
+            _err  = rx.err();
+            _done = true;
+            return false;
+        }
+    }
+    else if (LiteralSearch(find, match_case).is_fast() == false) {
+        _done = true;
+        return false;
+    }
+    _thread = std::thread(IncrementalSearch::ThreadFunc, this, find, match_case, regex);
+    return true;
 }
-void StatusBarInfo::debug() const {
-#ifdef DEBUG
-    printf("\nStatusBarInfo:\n");
-    printf("    start              = %9d\n", start);
-    printf("    end                = %9d\n", end);
-    printf("    pos                = %9d\n", pos);
-    printf("    selected           = %9d\n", end - start);
-    printf("    rows               = %9d\n", rows);
-    printf("    row                = %9d\n", row);
-    printf("    column             = %9d\n", col);
-#endif
+bool IncrementalSearch::_wait(int start, int end) const {
+    auto need = 0;
+    if (start < _line) {
+        need = _length - _line + std::min(end, _line);
+    }
+    else if (end > _line) {
+        need = std::min(end, _length) - _line;
+    }
+    while (_copied < need && _cancel == false) {
+        flw::util::sleep(1);
+    }
+    return _cancel == false;
 }
-gnu::file::Buf string::binary_to_hex(const void* in, size_t in_size, bool wide) {
-    auto W  = 79.0;
-    auto B1 = 16.0;
-    auto B2 = 16;
-    if (wide == true) {
-        W  = 147.0;
-        B1 = 32.0;
-        B2 = 32;
+bool IncrementalSearch::take_nearest(int& start, int& end) {
+    if (_taken == true || _nearest_start < 0) {
+        return false;
     }
-    auto size = static_cast<size_t>((in_size / B1 * W) + 4096);
-    auto fbuf = gnu::file::Buf(size);
-    auto pos  = (size_t) 0;
-    auto buf  = static_cast<const unsigned char*>(in);
-    auto p    = fbuf.str();
-#ifdef DEBUG_EDITOR
-    auto start = gnu::Time::Milli();
-#endif
-    for (size_t f = 0; f < in_size;) {
-        sprintf(fbuf.str() + pos, "%08x:", static_cast<unsigned>(f));
-        pos += 8;
-        for (int e = 0; e < B2; e++) {
-            if (f + e < in_size) {
-                auto c = buf[f + e];
-                auto h = 2 * c;
-                p[pos++] = ' ';
-                p[pos++] = fle::_FLE_HEX_STRINGS[h];
-                p[pos++] = fle::_FLE_HEX_STRINGS[h + 1];
-            }
-            else {
-                p[pos++] = ' ';
-                p[pos++] = ' ';
-                p[pos++] = ' ';
-            }
-            if (e == 7 || (B2 > 16 && (e == 15 || e == 23))) {
-                p[pos++] = ' ';
-                p[pos++] = '|';
+    _taken = true;
+    start  = _nearest_start;
+    end    = _nearest_end;
+    return true;
+}
+bool IncrementalSearch::take_ranges(RangeVector& ranges) {
+    ranges.clear();
+    if (_done == false || _count == 0 || _ranges.size() != static_cast<size_t>(_count)) {
+        return false;
+    }
+    std::rotate(_ranges.begin(), _ranges.begin() + _wrap, _ranges.end());
+    ranges.swap(_ranges);
+    return true;
+}
+void IncrementalSearch::ThreadFunc(IncrementalSearch* self, std::string find, bool match_case, bool regex) {
+    if (regex == true) {
+        auto rx = gnu::pcre8::PCRE(find, true);
+        rx.notempty(true);
+        self->_search_regex(rx, self->_origin, self->_length);
+        self->_wrap = self->_ranges.size();
+        self->_search_regex(rx, 0, self->_origin);
+    }
+    else {
+        auto search = LiteralSearch(find, match_case);
+        self->_search_literal(search, self->_origin, self->_length);
+        self->_wrap = self->_ranges.size();
+        self->_search_literal(search, 0, self->_origin);
+    }
+    self->_done = true;
+}
+LiteralSearch::LiteralSearch(const std::string& find, bool match_case) {
+    _fast       = true;
+    _find       = find;
+    _match_case = match_case;
+    _needle     = find;
+    auto len    = static_cast<int>(_needle.length());
+    if (match_case == false) {
+        for (auto& c : _needle) {
+            if (static_cast<unsigned char>(c) >= 128) {
+                _fast = false;
             }
+            c = LiteralSearch::Lower(c);
         }
-        p[pos++] = ' ';
-        p[pos++] = '|';
-        p[pos++] = ' ';
-        for (int e = 0; e < B2; e++) {
-            if (f + e < in_size) {
-                auto c = buf[f + e];
-                if (c < 32 || c > 126) {
-                    p[pos++] = '.';
-                }
-                else {
-                    p[pos++] = c;
-                }
-            }
-            else {
-                p[pos++] = ' ';
-            }
+    }
+    for (auto f = 0; f < 256; f++) {
+        _skip[f] = len;
+    }
+    for (auto f = 0; f < len - 1; f++) {
+        auto c = static_cast<unsigned char>(_needle[f]);
+        _skip[c] = len - 1 - f;
+        if (match_case == false && c >= 'a' && c <= 'z') {
+            _skip[c - 32] = len - 1 - f;
         }
-        p[pos++]  = '\n';
-        p[pos] = 0;
-        f += B2;
+    }
+}
+bool LiteralSearch::_compare(const char* in) const {
+    auto len = static_cast<int>(_needle.length());
+    if (_match_case == true) {
+        return memcmp(in, _needle.c_str(), len) == 0;
+    }
+    for (auto f = 0; f < len; f++) {
+        if (LiteralSearch::Lower(in[f]) != static_cast<unsigned char>(_needle[f])) {
+            return false;
+        }
+    }
+    return true;
+}
+int LiteralSearch::find(const char* in, int in_len, int start) const {
+    auto len = static_cast<int>(_needle.length());
+    if (len == 0 || start < 0 || in_len - start < len) {
+        return -1;
+    }
+    auto last   = in_len - len;
+    auto needle = _needle.c_str();
+    if (_match_case == true && len < LiteralSearch::HORSPOOL_LEN) {
+        auto p   = in + start;
+        auto end = in + last + 1;
+        while (p < end) {
+            p = static_cast<const char*>(memchr(p, needle[0], end - p));
+            if (p == nullptr) {
+                return -1;
+            }
+            else if (p[len - 1] == needle[len - 1] && (len <= 2 || memcmp(p + 1, needle + 1, len - 2) == 0)) {
+                return static_cast<int>(p - in);
+            }
+            p++;
+        }
+        return -1;
+    }
+    auto nl  = static_cast<unsigned char>(needle[len - 1]);
+    auto pos = start;
+    while (pos <= last) {
+        auto c = static_cast<unsigned char>(in[pos + len - 1]);
+        if ((_match_case == true ? c : LiteralSearch::Lower(c)) == nl && _compare(in + pos) == true) {
+            return pos;
+        }
+        pos += _skip[c];
+    }
+    return -1;
+}
+int LiteralSearch::rfind(const char* in, int in_len, int start) const {
+    auto len = static_cast<int>(_needle.length());
+    if (len == 0 || start < 0 || in_len < len) {
+        return -1;
+    }
+    auto nf = static_cast<unsigned char>(_needle[0]);
+    auto nl = static_cast<unsigned char>(_needle[len - 1]);
+    for (auto pos = std::min(start, in_len - len); pos >= 0; pos--) {
+        auto cf = static_cast<unsigned char>(in[pos]);
+        auto cl = static_cast<unsigned char>(in[pos + len - 1]);
+        if (_match_case == false) {
+            cf = LiteralSearch::Lower(cf);
+            cl = LiteralSearch::Lower(cl);
+        }
+        if (cf == nf && cl == nl && _compare(in + pos) == true) {
+            return pos;
+        }
+    }
+    return -1;
+}
+size_t MatchIndex::_first(int pos) const {
+    auto index = _lower(pos);
+    while (index > 0 && _at(index - 1).second > pos) {
+        index--;
+    }
+    return index;
+}
+size_t MatchIndex::_lower(int pos) const {
+    auto split = _ranges.begin() + _split;
+    auto it    = std::lower_bound(_ranges.begin(), split, std::make_pair(pos, INT_MIN));
+    if (it == split) {
+        it = std::lower_bound(split, _ranges.end(), std::make_pair(pos - _shift, INT_MIN));
+    }
+    return static_cast<size_t>(it - _ranges.begin());
+}
+void MatchIndex::_move_split(size_t index) {
+    for (auto f = _split; f < index; f++) {
+        _ranges[f].first  += _shift;
+        _ranges[f].second += _shift;
+    }
+    for (auto f = index; f < _split; f++) {
+        _ranges[f].first  -= _shift;
+        _ranges[f].second -= _shift;
+    }
+    _split = index;
+}
+bool MatchIndex::pause(bool pause) {
+    if (pause == true) {
+        _paused++;
+        return false;
+    }
+    else if (_paused > 0 && --_paused > 0) {
+        return false;
+    }
+    auto stale = _stale;
+    _stale = false;
+    return stale;
+}
+void MatchIndex::rebuild(TextBuffer& buffer) {
+    _ranges.clear();
+    _shift = 0;
+    _split = 0;
+    if (_find == "" || (_regex == true && _rx.is_compiled() == false)) {
+        return;
+    }
+    _search(buffer.get_range(0, buffer.length()), 0, _ranges);
+    if (_ranges.size() > MatchIndex::MAX_RANGES) {
+        clear();
+    }
+}
+void MatchIndex::_search(const std::string& text, int offset, RangeVector& out) const {
+    auto len = static_cast<int>(text.length());
+    if (_regex == false) {
+        auto search = LiteralSearch(_find, _match_case);
+        auto pos    = 0;
+        if (search.is_fast() == false) {
+            return;
+        }
+        while ((pos = search.find(text.c_str(), len, pos)) >= 0) {
+            out.push_back(std::make_pair(offset + pos, offset + pos + search.length()));
+            pos += search.length();
+        }
+        return;
+    }
+    auto off = std::vector<int>();
+    auto pos = 0;
+    while (pos < len) {
+        auto nl    = static_cast<const char*>(memchr(text.c_str() + pos, '\n', len - pos));
+        auto eol   = (nl != nullptr) ? static_cast<int>(nl - text.c_str()) : len;
+        auto start = 0;
+        while (start <= eol - pos && _rx.exec_offsets(text.c_str() + pos, eol - pos, off, start) > 0) {
+            out.push_back(std::make_pair(offset + pos + off[0], offset + pos + off[1]));
+            start = std::max(off[1], start + 1);
+        }
+        pos = eol + 1;
+    }
+}
+void MatchIndex::set(const std::string& find, bool match_case, bool regex, RangeVector& ranges) {
+    _find       = find;
+    _match_case = match_case;
+    _regex      = regex;
+    _shift      = 0;
+    _split      = 0;
+    _ranges.swap(ranges);
+    ranges.clear();
+    if (_regex == true) {
+        _rx.compile(find, true);
+        _rx.notempty(true);
+    }
+}
+bool MatchIndex::update(TextBuffer& buffer, int pos, int inserted_size, int deleted_size) {
+    if (_find == "" || (_regex == true && _rx.is_compiled() == false)) {
+        return false;
+    }
+    else if (_paused > 0) {
+        _stale = true;
+        return false;
+    }
+    auto extra = (_regex == false && _find.find('\n') != std::string::npos) ? static_cast<int>(_find.length()) : 0;
+    auto delta = inserted_size - deleted_size;
+    auto start = buffer.line_start(std::max(pos - extra, 0));
+    auto end   = buffer.line_end(std::min(pos + inserted_size + extra, buffer.length()));
+    auto first = _first(start);
+    auto last  = std::max(first, _lower(end - delta));
+    auto found = RangeVector();
+    if (first != last) {
+        start = std::min(start, _at(first).first);
+        end   = std::max(end, _at(last - 1).second + delta);
+    }
+    auto count = last - first;
+    _move_split(last);
+    _shift += delta;
+    _search(buffer.get_range(start, end), start, found);
+    if (_ranges.size() - count + found.size() > MatchIndex::MAX_RANGES) {
+        clear();
+        return true;
+    }
+    std::copy(found.begin(), found.begin() + std::min(count, found.size()), _ranges.begin() + first);
+    if (found.size() < count) {
+        _ranges.erase(_ranges.begin() + first + found.size(), _ranges.begin() + last);
+    }
+    else if (found.size() > count) {
+        _ranges.insert(_ranges.begin() + last, found.begin() + count, found.end());
+    }
+    _split = first + found.size();
+    return count > 0 || found.size() > 0;
+}
+void MatchIndex::visible(int first, int last, RangeVector& out) const {
+    out.clear();
+    for (auto f = _first(first); f < _ranges.size(); f++) {
+        auto range = _at(f);
+        if (range.first > last) {
+            break;
+        }
+        out.push_back(range);
+    }
+}
+Message::Message(Config& config) : _config(config) {
+    _id = 0;
+    _id = _config.add_receiver(this);
+}
+Message::~Message() {
+    _config.remove_receiver(this);
+}
+MultiSearch::MultiSearch(const std::vector<std::string>& terms, bool match_case) {
+    _match_case = match_case;
+    _width      = 1;
+    for (auto f = 0; f < 256; f++) {
+        _class[f] = 0;
+    }
+    for (const auto& term : terms) {
+        if (term == "") {
+            continue;
+        }
+        _terms.push_back(term);
+        for (auto c : term) {
+            auto u = (match_case == true) ? static_cast<unsigned char>(c) : LiteralSearch::Lower(c);
+            if (_class[u] == 0) {
+                _class[u] = _width++;
+                if (match_case == false && u >= 'a' && u <= 'z') {
+                    _class[u - 32] = _class[u];
+                }
+            }
+        }
+    }
+    _next.assign(_width, -1);
+    _out.assign(1, 0);
+    for (const auto& term : _terms) {
+        auto state = 0;
+        for (auto c : term) {
+            auto& next = _next[state * _width + _class[static_cast<unsigned char>(c)]];
+            if (next < 0) {
+                next = static_cast<int>(_out.size());
+                _next.insert(_next.end(), _width, -1);
+                _out.push_back(0);
+            }
+            state = _next[state * _width + _class[static_cast<unsigned char>(c)]];
+        }
+        _out[state] = std::max(_out[state], static_cast<int>(term.length()));
+    }
+    auto fail  = std::vector<int>(_out.size(), 0);
+    auto queue = std::vector<int>();
+    for (auto c = 0; c < _width; c++) {
+        auto& next = _next[c];
+        if (next < 0) {
+            next = 0;
+        }
+        else {
+            queue.push_back(next);
+        }
+    }
+    for (size_t f = 0; f < queue.size(); f++) {
+        auto state = queue[f];
+        _out[state] = std::max(_out[state], _out[fail[state]]);
+        for (auto c = 0; c < _width; c++) {
+            auto& next = _next[state * _width + c];
+            if (next < 0) {
+                next = _next[fail[state] * _width + c];
+            }
+            else {
+                fail[next] = _next[fail[state] * _width + c];
+                queue.push_back(next);
+            }
+        }
+    }
+}
+int MultiSearch::find(const char* in, int in_len, int start) const {
+    if (_terms.size() == 0) {
+        return -1;
+    }
+    auto state = 0;
+    for (auto f = std::max(start, 0); f < in_len; f++) {
+        state = _next[state * _width + _class[static_cast<unsigned char>(in[f])]];
+        if (_out[state] > 0) {
+            return f - _out[state] + 1;
+        }
+    }
+    return -1;
+}
+std::vector<std::string> MultiSearch::Split(const std::string& find) {
+    auto res  = std::vector<std::string>();
+    auto term = std::string();
+    for (auto c : find) {
+        if (std::isspace(static_cast<unsigned char>(c)) != 0) {
+            if (term != "") {
+                res.push_back(term);
+            }
+            term = "";
+        }
+        else {
+            term += c;
+        }
+    }
+    if (term != "") {
+        res.push_back(term);
+    }
+    return res;
+}
+void ResultStore::_add(KIND kind, uint32_t file, int line, int col, const char* text, size_t len) {
+    while (len > 0 && text[len - 1] == '\r') {
+        len--;
+    }
+    _kind.push_back(kind);
+    _file.push_back(file);
+    _line.push_back(line);
+    _col.push_back(col);
+    _offset.push_back(_text.length());
+    if (len > limits::OUTPUT_LINE_LENGTH_VAL) {
+        _text.append(text, limits::OUTPUT_LINE_LENGTH_VAL);
+        _text += "|";
+    }
+    else {
+        _text.append(text, len);
+    }
+    _text += '\0';
+}
+void ResultStore::append(const ResultStore& other, size_t rows) {
+    auto ids  = std::vector<uint32_t>();
+    auto base = _text.length();
+    rows = std::min(rows, other.size());
+    for (const auto& filename : other._files) {
+        ids.push_back(_file_id(filename));
+    }
+    for (size_t f = 0; f < rows; f++) {
+        _kind.push_back(other._kind[f]);
+        _file.push_back((other._file[f] == NO_FILE) ? NO_FILE : ids[other._file[f]]);
+        _line.push_back(other._line[f]);
+        _col.push_back(other._col[f]);
+        _offset.push_back(base + other._offset[f]);
+    }
+    _text.append(other._text, 0, (rows < other.size()) ? other._offset[rows] : other._text.length());
+}
+void ResultStore::clear() {
+    auto empty = ResultStore();
+    swap(empty);
+}
+uint32_t ResultStore::_file_id(const std::string& filename) {
+    if (_files.size() > 0 && _files.back() == filename) {
+        return static_cast<uint32_t>(_files.size() - 1);
+    }
+    auto it = _ids.find(filename);
+    if (it != _ids.end()) {
+        return static_cast<uint32_t>(it->second);
+    }
+    _ids[filename] = static_cast<int>(_files.size());
+    _files.push_back(filename);
+    return static_cast<uint32_t>(_files.size() - 1);
+}
+std::string ResultStore::format(size_t row) const {
+    if (_kind[row] != KIND::MATCH) {
+        return text(row);
+    }
+    else if (_file[row] == NO_FILE) {
+        return gnu::str::format("%6d - %4d| %s", _line[row], _col[row], text(row));
+    }
+    return gnu::str::format("%s: %6d - %4d| %s", _files[_file[row]].c_str(), _line[row], _col[row], text(row));
+}
+void ResultStore::swap(ResultStore& other) {
+    _ids.swap(other._ids);
+    _text.swap(other._text);
+    _kind.swap(other._kind);
+    _col.swap(other._col);
+    _line.swap(other._line);
+    _offset.swap(other._offset);
+    _files.swap(other._files);
+    _file.swap(other._file);
+}
+StatusBarInfo::StatusBarInfo() {
+    col   = 0;
+    end   = 0;
+    pos   = 0;
+    row   = 0;
+    rows  = 0;
+    start = 0;
+}
+void StatusBarInfo::debug() const {
+#ifdef DEBUG
+    printf("\nStatusBarInfo:\n");
+    printf("    start              = %9d\n", start);
+    printf("    end                = %9d\n", end);
+    printf("    pos                = %9d\n", pos);
+    printf("    selected           = %9d\n", end - start);
+    printf("    rows               = %9d\n", rows);
+    printf("    row                = %9d\n", row);
+    printf("    column             = %9d\n", col);
+#endif
+}
+gnu::file::Buf string::binary_to_hex(const void* in, size_t in_size, bool wide) {
+    auto W  = 79.0;
+    auto B1 = 16.0;
+    auto B2 = 16;
+    if (wide == true) {
+        W  = 147.0;
+        B1 = 32.0;
+        B2 = 32;
+    }
+    auto size = static_cast<size_t>((in_size / B1 * W) + 4096);
+    auto fbuf = gnu::file::Buf(size);
+    auto pos  = (size_t) 0;
+    auto buf  = static_cast<const unsigned char*>(in);
+    auto p    = fbuf.str();
+#ifdef DEBUG_EDITOR
+    auto start = gnu::Time::Milli();
+#endif
+    for (size_t f = 0; f < in_size;) {
+        sprintf(fbuf.str() + pos, "%08x:", static_cast<unsigned>(f));
+        pos += 8;
+        for (int e = 0; e < B2; e++) {
+            if (f + e < in_size) {
+                auto c = buf[f + e];
+                auto h = 2 * c;
+                p[pos++] = ' ';
+                p[pos++] = fle::_FLE_HEX_STRINGS[h];
+                p[pos++] = fle::_FLE_HEX_STRINGS[h + 1];
+            }
+            else {
+                p[pos++] = ' ';
+                p[pos++] = ' ';
+                p[pos++] = ' ';
+            }
+            if (e == 7 || (B2 > 16 && (e == 15 || e == 23))) {
+                p[pos++] = ' ';
+                p[pos++] = '|';
+            }
+        }
+        p[pos++] = ' ';
+        p[pos++] = '|';
+        p[pos++] = ' ';
+        for (int e = 0; e < B2; e++) {
+            if (f + e < in_size) {
+                auto c = buf[f + e];
+                if (c < 32 || c > 126) {
+                    p[pos++] = '.';
+                }
+                else {
+                    p[pos++] = c;
+                }
+            }
+            else {
+                p[pos++] = ' ';
+            }
+        }
+        p[pos++]  = '\n';
+        p[pos] = 0;
+        f += B2;
     }
     fbuf.size(pos);
     return fbuf;
@@ -14078,48 +15347,23 @@ bool string::is_one_char(const char* in) {
     return true;
 }
 int string::make_word_list(const char* text, fle::StringSet& words, const fle::StringSet& custom) {
-    auto time     = gnu::Time::Milli();
-    auto tokens   = Token::MakeWord();
-    auto len      = strlen(text);
-    auto word_len = (size_t) 0;
-    auto tmp      = fle::StringHash();
-    char word[limits::AUTOCOMPLETE_WORD_SIZE_MAX + 10];
-    tmp.max_load_factor(0.8);
-    if (len > 1'000'000) {
-        tmp.reserve(50'000);
-    }
-    while (*text != 0) {
-        auto c = (unsigned char) *text;
-        auto t = tokens.get(c);
-        if (t & Token::LETTER) {
-            if (word_len < limits::AUTOCOMPLETE_WORD_SIZE_VAL) {
-                word[word_len] = c;
-                word_len++;
-            }
-        }
-        else if (word_len > 1 && word_len < limits::AUTOCOMPLETE_WORD_SIZE_VAL) {
-            word[word_len] = 0;
-            tmp.insert(word);
-            word_len = 0;
-        }
-        else {
-            word_len = 0;
-        }
-        text++;
-        if (tmp.size() > limits::AUTOCOMPLETE_LINES_VAL) {
-            break;
+    auto time  = gnu::Time::Milli();
+    auto len   = strlen(text);
+    auto scan  = WordScanner(text, len);
+    auto table = WordTable((len > 1'000'000) ? 50'000 : 1'024);
+    auto word  = (const char*) nullptr;
+    auto size  = (size_t) 0;
+    while (table.size() <= limits::AUTOCOMPLETE_LINES_VAL && scan.next(word, size) == true) {
+        if (size > 1 && size < limits::AUTOCOMPLETE_WORD_SIZE_VAL) {
+            table.add(word, size);
         }
     }
-    if (word_len > 1 && word_len < limits::AUTOCOMPLETE_WORD_SIZE_VAL) {
-        word[word_len] = 0;
-        tmp.insert(word);
-    }
     for (const auto& w : custom) {
-        tmp.insert(w);
-    }
-    for (const auto& w : tmp) {
         words.insert(w);
     }
+    for (const auto& span : table.spans()) {
+        words.emplace(span.word, span.len);
+    }
     time = gnu::Time::Milli() - time;
 #ifdef DEBUG_EDITOR
     printf("string::wordlist(%d words from %d bytes) in %u mS\n", (int) words.size(), (int) len, (unsigned) time);
@@ -14401,47 +15645,276 @@ Token& Token::set(uint8_t index_from, uint8_t index_to, uint16_t value) {
     }
     return *this;
 }
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+static bool _wordscanner_cpu() {
+    static const bool SSSE3 = __builtin_cpu_supports("ssse3");
+    return SSSE3;
+}
+__attribute__((target("ssse3")))
+static uint64_t _wordscanner_letters(const char* text, const uint8_t* lo, const uint8_t* hi) {
+    auto lo_table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lo));
+    auto hi_table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hi));
+    auto nibble   = _mm_set1_epi8(0x0F);
+    auto zero     = _mm_setzero_si128();
+    auto bits     = (uint64_t) 0;
+    for (int f = 0; f < 64; f += 16) {
+        auto bytes    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + f));
+        auto lo_class = _mm_shuffle_epi8(lo_table, _mm_and_si128(bytes, nibble));
+        auto hi_class = _mm_shuffle_epi8(hi_table, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble));
+        auto other    = _mm_cmpeq_epi8(_mm_and_si128(lo_class, hi_class), zero);
+        bits |= static_cast<uint64_t>(~_mm_movemask_epi8(other) & 0xFFFF) << f;
+    }
+    return bits;
 }
-namespace fle {
-Config::Config() {
-    _del               = false;
-    _id                = 0;
-    active             = nullptr;
-    disable_autoreload = false;
-    disable_lineending = false;
-    disable_style      = false;
-    disable_tab        = false;
-    pref_autocomplete  = true;
-    pref_autoreload    = true;
-    pref_backup        = gnu::file::File();
-    pref_binary        = FBinFile::NO;
-    pref_cursor        = Fl_Text_Display::NORMAL_CURSOR;
-    pref_highlight     = false;
-    pref_indentation   = true;
-    pref_insert        = true;
-    pref_linenumber    = true;
-    pref_mouse_scroll  = 3;
-    pref_scheme        = style::SCHEME_DEF;
-    pref_shrink_status = 0;
-    pref_statusbar     = true;
-    pref_tmp_fontsize  = 0;
-    pref_undo          = FUndoMode::FLE_V1;
-    pref_undo_buffer   = true;
-    pref_wrap          = 80;
-    _init_colors();
-    _init_keys();
-    _init_tabs();
-    init_scheme(flw::PREF_FIXED_FONTSIZE);
+#else
+static bool _wordscanner_cpu() {
+    return false;
 }
-bool Config::add_find_word(const std::string& word, bool append) {
-    if (word == "" || gnu::str::is_whitespace(word) == true || word.find_first_of("\n\r\t") != std::string::npos || word.length() > 80) {
-        return false;
-    }
-    if (find_list.size() > 0 && find_list.front() == word) {
-        return false;
+static uint64_t _wordscanner_letters(const char*, const uint8_t*, const uint8_t*) {
+    return 0;
+}
+#endif
+static int _wordscanner_ctz(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    auto res = 0;
+    while ((bits & 1) == 0) {
+        bits >>= 1;
+        res++;
     }
-    if (append == true) {
-        gnu::str::list_append(find_list, word, limits::FIND_LIST_MAX);
+    return res;
+#endif
+}
+WordScanner::WordScanner(const char* text, size_t len, bool simd) {
+    auto tokens   = Token::MakeWord();
+    auto patterns = std::vector<uint16_t>();
+    _block = 0;
+    _len   = len;
+    _simd  = simd == true && _wordscanner_cpu() == true;
+    _text  = text;
+    memset(_hi, 0, sizeof(_hi));
+    memset(_lo, 0, sizeof(_lo));
+    for (int f = 0; f < 256; f++) {
+        _table[f] = (tokens.get(f) & Token::LETTER) ? 1 : 0;
+    }
+    for (int h = 0; h < 16; h++) {
+        auto pattern = (uint16_t) 0;
+        for (int l = 0; l < 16; l++) {
+            pattern |= _table[h * 16 + l] << l;
+        }
+        if (pattern == 0) {
+            continue;
+        }
+        auto it = std::find(patterns.begin(), patterns.end(), pattern);
+        if (it == patterns.end()) {
+            it = patterns.insert(it, pattern);
+        }
+        auto bit = static_cast<uint8_t>(1 << ((it - patterns.begin()) & 7));
+        _hi[h] = bit;
+        for (int l = 0; l < 16; l++) {
+            if (pattern & (1 << l)) {
+                _lo[l] |= bit;
+            }
+        }
+    }
+    if (patterns.size() > 8) {
+        _simd = false;
+    }
+    _bits = (len > 0) ? _letters(0) : 0;
+}
+std::string WordScanner::Benchmark(const char* text, size_t len) {
+    auto tokens = Token::MakeWord();
+    auto hash   = StringHash();
+    auto words  = (size_t) 0;
+    auto size   = (size_t) 0;
+    auto word   = (const char*) nullptr;
+    char tmp[limits::AUTOCOMPLETE_WORD_SIZE_MAX + 10];
+    auto time1 = gnu::Time::Micro();
+    for (auto p = text, end = text + len; p <= end; p++) {
+        if (p < end && (tokens.get(static_cast<uint8_t>(*p)) & Token::LETTER)) {
+            if (size < limits::AUTOCOMPLETE_WORD_SIZE_VAL) {
+                tmp[size++] = *p;
+            }
+            continue;
+        }
+        else if (size > 1 && size < limits::AUTOCOMPLETE_WORD_SIZE_VAL) {
+            tmp[size] = 0;
+            hash.insert(tmp);
+            words++;
+        }
+        size = 0;
+    }
+    time1 = gnu::Time::Micro() - time1;
+    auto time = std::vector<int64_t>();
+    auto uniq = std::vector<size_t>();
+    for (auto simd : { false, true }) {
+        auto scan  = WordScanner(text, len, simd);
+        auto table = WordTable(50'000);
+        auto start = gnu::Time::Micro();
+        while (scan.next(word, size) == true) {
+            if (size > 1 && size < limits::AUTOCOMPLETE_WORD_SIZE_VAL) {
+                table.add(word, size);
+            }
+        }
+        time.push_back(gnu::Time::Micro() - start);
+        uniq.push_back(table.size());
+        if (simd == true && scan.is_simd() == false) {
+            time.back() = 0;
+        }
+    }
+    auto rate = [words](int64_t micro) { return (micro > 0) ? static_cast<double>(words) / static_cast<double>(micro) : 0.0; };
+    if (uniq[0] != hash.size() || uniq[1] != hash.size()) {
+        return gnu::str::format("word count mismatch: %d/%d/%d", (int) hash.size(), (int) uniq[0], (int) uniq[1]);
+    }
+    return gnu::str::format("%9d words| %7d unique| bytes+hash: %6.1f Mw/s| scalar+table: %6.1f Mw/s| simd+table: %6.1f Mw/s", (int) words, (int) hash.size(), rate(time1), rate(time[0]), rate(time[1]));
+}
+uint64_t WordScanner::_letters(size_t pos) const {
+    auto end = std::min(pos + 64, _len);
+    if (_simd == true && end - pos == 64) {
+        return _wordscanner_letters(_text + pos, _lo, _hi);
+    }
+    auto bits = (uint64_t) 0;
+    for (auto f = pos; f < end; f++) {
+        bits |= static_cast<uint64_t>(_table[static_cast<uint8_t>(_text[f])]) << (f - pos);
+    }
+    return bits;
+}
+bool WordScanner::next(const char*& word, size_t& len) {
+    while (_bits == 0) {
+        _block += 64;
+        if (_block >= _len) {
+            return false;
+        }
+        _bits = _letters(_block);
+    }
+    auto start = _block + _wordscanner_ctz(_bits);
+    auto rest  = ~_bits & (~(uint64_t) 0 << _wordscanner_ctz(_bits));
+    while (rest == 0) {
+        _block += 64;
+        if (_block >= _len) {
+            _bits = 0;
+            word  = _text + start;
+            len   = _len - start;
+            return true;
+        }
+        _bits = _letters(_block);
+        rest  = ~_bits;
+    }
+    auto end = _wordscanner_ctz(rest);
+    _bits &= ~(uint64_t) 0 << end;
+    word = _text + start;
+    len  = _block + end - start;
+    return true;
+}
+WordTable::WordTable(size_t reserve) {
+    auto size = (size_t) 16;
+    while (size < reserve * 2) {
+        size *= 2;
+    }
+    _slots.resize(size);
+    _spans.reserve(reserve);
+}
+bool WordTable::add(const char* word, size_t len, bool insert) {
+    auto hash = WordTable::Hash(word, len);
+    auto mask = _slots.size() - 1;
+    auto f    = static_cast<size_t>(hash) & mask;
+    while (_slots[f] != 0) {
+        auto& span = _spans[_slots[f] - 1];
+        if (span.hash == hash && span.len == len && memcmp(span.word, word, len) == 0) {
+            span.count++;
+            return false;
+        }
+        f = (f + 1) & mask;
+    }
+    if (insert == false) {
+        return false;
+    }
+    _spans.push_back(Span{word, hash, static_cast<uint32_t>(len), 1});
+    if (_spans.size() * 2 > _slots.size()) {
+        _grow();
+    }
+    else {
+        _slots[f] = static_cast<uint32_t>(_spans.size());
+    }
+    return true;
+}
+void WordTable::_grow() {
+    _slots.assign(_slots.size() * 2, 0);
+    auto mask = _slots.size() - 1;
+    for (size_t i = 0; i < _spans.size(); i++) {
+        auto f = static_cast<size_t>(_spans[i].hash) & mask;
+        while (_slots[f] != 0) {
+            f = (f + 1) & mask;
+        }
+        _slots[f] = static_cast<uint32_t>(i + 1);
+    }
+}
+void WordTable::release() {
+    std::vector<Span>().swap(_spans);
+    _slots.assign(16, 0);
+    _slots.shrink_to_fit();
+}
+uint64_t WordTable::Hash(const char* word, size_t len) {
+    auto hash = 0x9E37'79B9'7F4A'7C15ull ^ len;
+    auto v    = (uint64_t) 0;
+    while (len >= 8) {
+        memcpy(&v, word, 8);
+        hash  = (hash ^ v) * 0xFF51'AFD7'ED55'8CCDull;
+        hash ^= hash >> 32;
+        word += 8;
+        len  -= 8;
+    }
+    if (len > 0) {
+        v = 0;
+        memcpy(&v, word, len);
+        hash  = (hash ^ v) * 0xC4CE'B9FE'1A85'EC53ull;
+        hash ^= hash >> 29;
+    }
+    return hash;
+}
+}
+namespace fle {
+Config::Config() {
+    _del               = false;
+    _id                = 0;
+    active             = nullptr;
+    disable_autoreload = false;
+    disable_lineending = false;
+    disable_style      = false;
+    disable_tab        = false;
+    pref_autocomplete  = true;
+    pref_autoreload    = true;
+    pref_backup        = gnu::file::File();
+    pref_binary        = FBinFile::NO;
+    pref_cursor        = Fl_Text_Display::NORMAL_CURSOR;
+    pref_highlight     = false;
+    pref_indentation   = true;
+    pref_insert        = true;
+    pref_linenumber    = true;
+    pref_mouse_scroll  = 3;
+    pref_scheme        = style::SCHEME_DEF;
+    pref_shrink_status = 0;
+    pref_statusbar     = true;
+    pref_tmp_fontsize  = 0;
+    pref_undo          = FUndoMode::FLE_V1;
+    pref_undo_buffer   = true;
+    pref_undo_compress = true;
+    pref_wrap          = 80;
+    _init_colors();
+    _init_keys();
+    _init_tabs();
+    init_scheme(flw::PREF_FIXED_FONTSIZE);
+}
+bool Config::add_find_word(const std::string& word, bool append) {
+    if (word == "" || gnu::str::is_whitespace(word) == true || word.find_first_of("\n\r\t") != std::string::npos || word.length() > 80) {
+        return false;
+    }
+    if (find_list.size() > 0 && find_list.front() == word) {
+        return false;
+    }
+    if (append == true) {
+        gnu::str::list_append(find_list, word, limits::FIND_LIST_MAX);
     }
     else {
         gnu::str::list_insert(find_list, word, limits::FIND_LIST_MAX);
@@ -14509,6 +15982,7 @@ void Config::debug() const {
     printf("    pref_tmp_fontsize  = %2d\n", pref_tmp_fontsize);
     printf("    pref_undo          = %2d\n", (int) pref_undo);
     printf("    pref_undo_buffer   = %s\n", pref_undo_buffer ? "true" : "false");
+    printf("    pref_undo_compress = %s\n", pref_undo_compress ? "true" : "false");
     printf("    pref_wrap          = %2u\n", pref_wrap);
     fflush(stdout);
 #endif
@@ -14892,7 +16366,7 @@ void Config::load_pref(Fl_Preferences& pref, FindReplace* findreplace) {
         limits::FILE_SIZE_VAL = ((unsigned) val >= limits::FILE_SIZE_MIN && (unsigned) val <= limits::FILE_SIZE_MAX) ? val : limits::FILE_SIZE_DEF;
         pref.get("tweak.force_restyling", val, 0);
         limits::FORCE_RESTYLING = (val == 1) ? 1 : 0;
-        pref.get("tweak.output_lines", val, 0);
+        pref.get("tweak.output_lines", val, (int) limits::OUTPUT_LINES_DEF);
         limits::OUTPUT_LINES_VAL = ((unsigned) val >= limits::OUTPUT_LINES_MIN && (unsigned) val <= limits::OUTPUT_LINES_MAX) ? val : limits::OUTPUT_LINES_DEF;
         pref.get("tweak.output_line_length", val, 0);
         limits::OUTPUT_LINE_LENGTH_VAL = ((unsigned) val >= limits::OUTPUT_LINE_LENGTH_MIN && (unsigned) val <= limits::OUTPUT_LINE_LENGTH_MAX) ? val : limits::OUTPUT_LINE_LENGTH_DEF;
@@ -14900,12 +16374,22 @@ void Config::load_pref(Fl_Preferences& pref, FindReplace* findreplace) {
         limits::SCROLL_VAL = ((unsigned) val >= limits::SCROLL_MIN && (unsigned) val <= limits::SCROLL_MAX) ? val : limits::SCROLL_DEF;
         pref.get("tweak.style_filesize", val, 0);
         limits::STYLE_FILESIZE_VAL = ((unsigned) val >= limits::STYLE_FILESIZE_MIN && (unsigned) val <= limits::STYLE_FILESIZE_MAX) ? val : limits::STYLE_FILESIZE_DEF;
+        pref.get("tweak.undo_memory", val, 0);
+        limits::UNDO_MEMORY_VAL = ((unsigned) val >= limits::UNDO_MEMORY_MIN && (unsigned) val <= limits::UNDO_MEMORY_MAX) ? val : limits::UNDO_MEMORY_DEF;
+        pref.get("tweak.undo_memory_all", val, 0);
+        limits::UNDO_MEMORY_ALL_VAL = ((unsigned) val >= limits::UNDO_MEMORY_ALL_MIN && (unsigned) val <= limits::UNDO_MEMORY_ALL_MAX) ? val : limits::UNDO_MEMORY_ALL_DEF;
         pref.get("tweak.wrap_line_length", val, 0);
         limits::WRAP_LINE_LENGTH_VAL = ((unsigned) val >= limits::WRAP_LINE_LENGTH_MIN && (unsigned) val <= limits::WRAP_LINE_LENGTH_MAX) ? val : limits::WRAP_LINE_LENGTH_DEF;
     }
     {
+        pref.get("finddialog.fcase", val, (int) FCaseCompare::YES);
+        FindDialog::CASE = (val == (int) FCaseCompare::NO) ? FCaseCompare::NO : FCaseCompare::YES;
         pref.get("finddialog.fregex", val, 0);
         FindDialog::REGEX = (val == (int) FRegex::YES) ? FRegex::YES : FRegex::NO;
+        pref.get("finddialog.fscope", val, 0);
+        FindDialog::SCOPE = (val >= (int) FScope::ALL && val <= (int) FScope::STRINGS) ? (FScope) val : FScope::ALL;
+        pref.get("finddialog.fterms", val, 0);
+        FindDialog::TERMS = (val == (int) FTerms::YES && FindDialog::REGEX == FRegex::NO) ? FTerms::YES : FTerms::NO;
         pref.get("finddialog.ftrim", val, 0);
         FindDialog::TRIM = (val == (int) FTrim::YES) ? FTrim::YES : FTrim::NO;
     }
@@ -14916,6 +16400,8 @@ void Config::load_pref(Fl_Preferences& pref, FindReplace* findreplace) {
         ReplaceDialog::NLTAB = (val >= (int) FNlTab::NO && val <= (int) FNlTab::YES) ? (FNlTab) val : FNlTab::NO;
         pref.get("replacedialog.fregex", val, 0);
         ReplaceDialog::REGEX = (val == (int) FRegex::YES) ? FRegex::YES : FRegex::NO;
+        pref.get("replacedialog.fscope", val, 0);
+        ReplaceDialog::SCOPE = (val >= (int) FScope::ALL && val <= (int) FScope::STRINGS) ? (FScope) val : FScope::ALL;
         pref.get("replacedialog.fselection", val, 0);
         ReplaceDialog::SELECTION = (val == (int) FSelection::YES) ? FSelection::YES : FSelection::NO;
         pref.get("replacedialog.fwordcompare", val, 0);
@@ -14934,6 +16420,8 @@ void Config::load_pref(Fl_Preferences& pref, FindReplace* findreplace) {
         findreplace->fwordcompare((val == (int) FWordCompare::YES) ? FWordCompare::YES : FWordCompare::NO);
         pref.get("findreplace.fregex", val, 0);
         findreplace->fregex((val == (int) FRegex::YES) ? FRegex::YES : FRegex::NO);
+        pref.get("findreplace.fscope", val, 0);
+        findreplace->fscope((val >= (int) FScope::ALL && val <= (int) FScope::STRINGS) ? (FScope) val : FScope::ALL);
     }
     {
         pref.get("fle.wordwrap", val, 80);
@@ -15104,18 +16592,25 @@ void Config::save_pref(Fl_Preferences& pref, FindReplace* findreplace) {
     pref.set("tweak.force_restyling", (int) limits::FORCE_RESTYLING);
     pref.set("tweak.scroll", (int) limits::SCROLL_VAL);
     pref.set("tweak.style_filesize", (int) limits::STYLE_FILESIZE_VAL);
+    pref.set("tweak.undo_memory", (int) limits::UNDO_MEMORY_VAL);
+    pref.set("tweak.undo_memory_all", (int) limits::UNDO_MEMORY_ALL_VAL);
     pref.set("tweak.wrap_line_length", (int) limits::WRAP_LINE_LENGTH_VAL);
+    pref.set("finddialog.fcase", (int) FindDialog::CASE);
     pref.set("finddialog.fregex", (int) FindDialog::REGEX);
+    pref.set("finddialog.fscope", (int) FindDialog::SCOPE);
+    pref.set("finddialog.fterms", (int) FindDialog::TERMS);
     pref.set("finddialog.ftrim", (int) FindDialog::TRIM);
     pref.set("replacedialog.fcasecompare", (int) ReplaceDialog::CASECOMPARE);
     pref.set("replacedialog.fnltab", (int) ReplaceDialog::NLTAB);
     pref.set("replacedialog.fregex", (int) ReplaceDialog::REGEX);
+    pref.set("replacedialog.fscope", (int) ReplaceDialog::SCOPE);
     pref.set("replacedialog.fselection", (int) ReplaceDialog::SELECTION);
     pref.set("replacedialog.fwordcompare", (int) ReplaceDialog::WORDCOMPARE);
     if (findreplace != nullptr) {
         pref.set("findreplace.fcasecompare", (int) findreplace->fcasecompare());
         pref.set("findreplace.fnltab", (int) findreplace->fnltab());
         pref.set("findreplace.fregex", (int) findreplace->fregex());
+        pref.set("findreplace.fscope", (int) findreplace->fscope());
         pref.set("findreplace.fselection", (int) findreplace->fselection());
         pref.set("findreplace.fwordcompare", (int) findreplace->fwordcompare());
     }
@@ -18117,6 +19612,492 @@ int StyleMarkup::_update(int start, int end) {
     }
     return start;
 }
+WordIndex::Bucket                       WordIndex::BUCKETS[32 * 2 * 16];
+size_t                                  WordIndex::GARBAGE = 0;
+std::vector<WordIndex*>                 WordIndex::INDEXES;
+std::vector<uint64_t>                   WordIndex::KEYS;
+WordIndex::Pool                         WordIndex::POOL;
+std::vector<WordIndex::Slot>            WordIndex::SLOTS;
+std::string                             WordIndex::TEXT;
+WordIndex::WordIndex() {
+    _active = false;
+    _cancel = false;
+    _done   = true;
+    _length = 0;
+    _limit  = INT_MAX;
+    _peak   = 0;
+    _size   = 0;
+    _text   = nullptr;
+    _time   = 0;
+    _tokens = Token::MakeWord();
+    WordIndex::INDEXES.push_back(this);
+}
+WordIndex::~WordIndex() {
+    clear();
+    WordIndex::INDEXES.erase(std::find(WordIndex::INDEXES.begin(), WordIndex::INDEXES.end(), this));
+}
+void WordIndex::build(char* text, size_t len) {
+    cancel();
+    _done   = false;
+    _length = std::min(len, limits::AUTOCOMPLETE_FILESIZE_VAL);
+    _limit  = (_length < len) ? static_cast<int>(_length) : INT_MAX;
+    _text   = text;
+    _time   = gnu::Time::Milli();
+    _thread = std::thread(WordIndex::ThreadFunc, this);
+}
+void WordIndex::cancel() {
+    _cancel = true;
+    if (_thread.joinable() == true) {
+        _thread.join();
+    }
+    _cancel = false;
+    _done   = true;
+    _built.release();
+    _journal.clear();
+    free(_text);
+    _length = 0;
+    _text   = nullptr;
+}
+void WordIndex::clear() {
+    cancel();
+    _reset();
+    clear_fixed();
+    _active = false;
+    _limit  = INT_MAX;
+}
+void WordIndex::clear_fixed() {
+    for (size_t f = 0; f < _count.size(); f++) {
+        if (_count[f] == WordIndex::FIXED) {
+            _release(static_cast<unsigned>(f));
+        }
+        else {
+            _count[f] &= ~WordIndex::FIXED;
+        }
+    }
+    WordIndex::_Compact();
+}
+int WordIndex::_Bonus(unsigned count) {
+    return (count > 0) ? static_cast<int>(std::log2(1.0 + count) * 3.0) : 0;
+}
+void WordIndex::_Compact() {
+    if (WordIndex::GARBAGE <= WordIndex::TEXT.length() / 2) {
+        return;
+    }
+    auto map   = std::vector<unsigned>(WordIndex::SLOTS.size(), WordIndex::NONE);
+    auto keys  = std::vector<uint64_t>();
+    auto slots = std::vector<Slot>();
+    auto text  = std::string();
+    text.reserve(WordIndex::TEXT.length() - WordIndex::GARBAGE);
+    for (auto& bucket : WordIndex::BUCKETS) {
+        bucket.keys.clear();
+        bucket.heads.clear();
+    }
+    for (size_t f = 0; f < WordIndex::SLOTS.size(); f++) {
+        auto& slot = WordIndex::SLOTS[f];
+        if (slot.word == nullptr) {
+            continue;
+        }
+        map[f] = static_cast<unsigned>(slots.size());
+        slot.word->second.slot = map[f];
+        keys.push_back(WordIndex::KEYS[f]);
+        slots.push_back(Slot{slot.word, static_cast<uint32_t>(text.length()), slot.length});
+        text.append(WordIndex::TEXT, slot.offset, slot.length);
+        WordIndex::_Heads(map[f], slot.word->first, WordIndex::KEYS[f]);
+    }
+    for (auto index : WordIndex::INDEXES) {
+        auto count = std::vector<unsigned>();
+        for (size_t f = 0; f < index->_count.size(); f++) {
+            if (index->_count[f] != 0) {
+                count.resize(map[f] + 1);
+                count[map[f]] = index->_count[f];
+            }
+        }
+        index->_count = std::move(count);
+    }
+    WordIndex::KEYS    = std::move(keys);
+    WordIndex::SLOTS   = std::move(slots);
+    WordIndex::TEXT    = std::move(text);
+    WordIndex::GARBAGE = 0;
+}
+size_t WordIndex::complete(const std::string& query, const TextBuffer& buffer, int pos, std::vector<std::string>& out) const {
+    struct Candidate {
+        int                     rank;
+        uint32_t                slot;
+    };
+    auto lower  = [](uint8_t c) { return (c >= 'A' && c <= 'Z') ? c + 32 : c; };
+    auto first  = (query.empty() == false) ? static_cast<uint8_t>(query[0]) : 0;
+    auto len    = static_cast<int>(query.length());
+    auto key    = WordIndex::Key(query.c_str(), query.length(), true);
+    auto keys   = WordIndex::KEYS.data();
+    auto counts = _count.data();
+    auto size   = _count.size();
+    auto text   = WordIndex::TEXT.data();
+    auto found  = std::vector<Candidate>();
+    auto near   = std::vector<uint8_t>(WordIndex::SLOTS.size());
+    auto close  = std::vector<uint32_t>();
+    auto order  = std::vector<std::pair<int, size_t>>();
+    auto tail   = std::vector<uint64_t>();
+    auto peak   = WordIndex::LOCAL + WordIndex::_Bonus(_peak);
+    auto cut    = -1;
+    auto prune  = WordIndex::MAX_COMPLETE * 2;
+    auto offset = std::max(pos - WordIndex::PROXIMITY, 0);
+    auto around = buffer.get_range(offset, std::min(pos + WordIndex::PROXIMITY, buffer.length()));
+    auto start  = (size_t) 0;
+    uint8_t keep[256];
+    auto rank   = [counts, size, &near](uint32_t slot) {
+        auto count = (slot < size) ? counts[slot] : 0;
+        auto local = (count != 0) ? WordIndex::LOCAL : 0;
+        count &= ~WordIndex::FIXED;
+        return (count > 0) ? local + WordIndex::_Bonus(count) + near[slot] : local;
+    };
+    auto push   = [&](uint32_t slot, int rank) {
+        if (rank < cut || keys[slot] == 0) {
+            return;
+        }
+        found.push_back(Candidate{rank, slot});
+        if (found.size() >= prune) {
+            std::nth_element(found.begin(), found.begin() + WordIndex::MAX_COMPLETE - 1, found.end(), [](const Candidate& a, const Candidate& b) { return a.rank > b.rank; });
+            cut = found[WordIndex::MAX_COMPLETE - 1].rank;
+            found.erase(std::partition(found.begin(), found.end(), [cut](const Candidate& c) { return c.rank >= cut; }), found.end());
+            prune = std::max(prune, found.size() * 2);
+        }
+    };
+    out.clear();
+    for (size_t f = 0; f <= around.length(); f++) {
+        if (f < around.length() && (_tokens.get(static_cast<uint8_t>(around[f])) & Token::LETTER)) {
+            continue;
+        }
+        auto word = std::string_view(around.c_str() + start, f - start);
+        auto slot = (word.length() > 1 && (WordIndex::Key(word.data(), word.length()) & key) == key) ? _find(word) : WordIndex::NONE;
+        if (slot != WordIndex::NONE) {
+            auto dist = std::abs(static_cast<int>(offset + start) - pos);
+            if (near[slot] == 0) {
+                close.push_back(slot);
+            }
+            near[slot] = std::max(near[slot], static_cast<uint8_t>(20 - dist * 20 / (WordIndex::PROXIMITY + 1)));
+        }
+        start = f + 1;
+    }
+    for (auto slot : close) {
+        auto& word  = WordIndex::SLOTS[slot];
+        auto  score = WordIndex::Score(query.c_str(), query.length(), text + word.offset, word.length);
+        if (score >= 0) {
+            push(slot, rank(slot) + score);
+        }
+    }
+    for (size_t f = 1; f < query.length(); f++) {
+        tail.push_back((uint64_t) 1 << ((lower(static_cast<uint8_t>(query[f])) & 31) + 32));
+    }
+    for (unsigned bit = 0; bit < 32; bit++) {
+        for (size_t length = 0; length < WordIndex::LENGTHS * 4; length += 4) {
+            if (len == 0) {
+                order.emplace_back(0, WordIndex::_Bucket(bit, 0, length));
+            }
+            else if (bit == (lower(first) & 31)) {
+                auto penalty = (static_cast<int>(length) > len) ? (static_cast<int>(length) - len) / 4 : 0;
+                order.emplace_back(std::max(11 + 9 * (len - 1) - penalty, 0), WordIndex::_Bucket(bit, 0, length));
+                order.emplace_back(std::max(9 + 9 * (len - 1) - penalty, 0), WordIndex::_Bucket(bit, 1, length));
+            }
+        }
+    }
+    std::sort(order.begin(), order.end(), [](const std::pair<int, size_t>& a, const std::pair<int, size_t>& b) { return a.first > b.first; });
+    for (const auto& bucket : order) {
+        auto& bkeys = WordIndex::BUCKETS[bucket.second].keys;
+        auto& heads = WordIndex::BUCKETS[bucket.second].heads;
+        if (peak + bucket.first < cut) {
+            break;
+        }
+        for (size_t block = 0; block < bkeys.size(); block += sizeof(keep)) {
+            auto size = std::min(bkeys.size() - block, sizeof(keep));
+            auto hits = (size_t) 0;
+            for (size_t f = 0; f < size; f++) {
+                keep[hits] = static_cast<uint8_t>(f);
+                hits += (bkeys[block + f] & key) == key;
+            }
+            for (size_t f = 0; f < hits; f++) {
+                auto& head = heads[block + keep[f]];
+                auto  bits = bkeys[block + keep[f]];
+                if (len == 0 && head.at != 0) {
+                    continue;
+                }
+                auto length = (head.length < UINT8_MAX) ? head.length : static_cast<int>(WordIndex::SLOTS[head.slot].length);
+                auto c      = (head.at < sizeof(head.text)) ? static_cast<uint8_t>(head.text[head.at]) : 0;
+                auto known  = len > 0 && c != 0 && lower(c) == lower(first);
+                auto score  = (known == true) ? ((head.at == 0) ? 10 : 8) + ((c == first) ? 1 : 0) : 11;
+                for (auto bit : tail) {
+                    score += ((bits & bit) != 0) ? 9 : 6;
+                }
+                score = (len == 0) ? 0 : std::max(score - (length - len) / 4, 0);
+                if (length < len || peak + score < cut) {
+                    continue;
+                }
+                else if (len > 1 || known == false) {
+                    auto word = (length <= static_cast<int>(sizeof(head.text))) ? head.text : text + WordIndex::SLOTS[head.slot].offset;
+                    score = WordIndex::Score(query.c_str(), query.length(), word, length);
+                    if (score < 0 || peak + score < cut) {
+                        continue;
+                    }
+                }
+                if (near[head.slot] == 0) {
+                    push(head.slot, rank(head.slot) + score);
+                }
+            }
+        }
+    }
+    auto end  = found.begin() + std::min(found.size(), WordIndex::MAX_COMPLETE);
+    auto less = [text](const Candidate& a, const Candidate& b) {
+        if (a.rank != b.rank) {
+            return a.rank > b.rank;
+        }
+        auto& s1 = WordIndex::SLOTS[a.slot];
+        auto& s2 = WordIndex::SLOTS[b.slot];
+        return std::string_view(text + s1.offset, s1.length) < std::string_view(text + s2.offset, s2.length);
+    };
+    if (end != found.end()) {
+        std::nth_element(found.begin(), end - 1, found.end(), [](const Candidate& a, const Candidate& b) { return a.rank > b.rank; });
+        auto rank = (end - 1)->rank;
+        auto tie  = std::partition(found.begin(), found.end(), [rank](const Candidate& c) { return c.rank > rank; });
+        std::nth_element(tie, end, std::partition(tie, found.end(), [rank](const Candidate& c) { return c.rank == rank; }), less);
+    }
+    std::sort(found.begin(), end, less);
+    for (auto it = found.begin(); it != end; ++it) {
+        auto& slot = WordIndex::SLOTS[it->slot];
+        out.emplace_back(text + slot.offset, slot.length);
+    }
+    return out.size();
+}
+unsigned WordIndex::_find(std::string_view word) const {
+    auto it = WordIndex::POOL.find(std::string(word));
+    if (it == WordIndex::POOL.end() || it->second.slot >= _count.size() || _count[it->second.slot] == 0) {
+        return WordIndex::NONE;
+    }
+    return it->second.slot;
+}
+void WordIndex::_Heads(unsigned slot, std::string_view word, uint64_t key) {
+    auto done = (uint32_t) 0;
+    for (size_t f = 0; f < word.length(); f++) {
+        auto c    = static_cast<uint8_t>(word[f]);
+        auto bit  = ((c >= 'A' && c <= 'Z') ? c + 32 : c) & 31;
+        auto head = f == 0 || word[f - 1] == '_' || (c >= 'A' && c <= 'Z' && word[f - 1] >= 'a' && word[f - 1] <= 'z');
+        if (head == true && (done & (1u << bit)) == 0) {
+            auto& bucket = WordIndex::BUCKETS[WordIndex::_Bucket(bit, f, word.length())];
+            auto& h      = bucket.heads.emplace_back();
+            done |= 1u << bit;
+            bucket.keys.push_back(key);
+            h.slot   = slot;
+            h.length = static_cast<uint8_t>(std::min(word.length(), (size_t) UINT8_MAX));
+            h.at     = static_cast<uint8_t>(std::min(f, (size_t) UINT8_MAX));
+            memset(h.text, 0, sizeof(h.text));
+            memcpy(h.text, word.data(), std::min(word.length(), sizeof(h.text)));
+        }
+    }
+}
+void WordIndex::insert(const StringSet& words) {
+    for (const auto& w : words) {
+        auto slot = _retain(w);
+        _count[slot] |= WordIndex::FIXED;
+    }
+}
+uint64_t WordIndex::Key(const char* word, size_t len, bool query) {
+    auto key = (uint64_t) 0;
+    for (size_t f = 0; f < len; f++) {
+        auto c   = static_cast<uint8_t>(word[f]);
+        auto bit = (uint64_t) 1 << (((c >= 'A' && c <= 'Z') ? c + 32 : c) & 31);
+        key |= bit;
+        if (f == 0 || (query == false && (word[f - 1] == '_' || (c >= 'A' && c <= 'Z' && word[f - 1] >= 'a' && word[f - 1] <= 'z')))) {
+            key |= bit << 32;
+        }
+    }
+    return key;
+}
+bool WordIndex::publish() {
+    if (_text == nullptr) {
+        return true;
+    }
+    else if (_done == false) {
+        return false;
+    }
+    _thread.join();
+    _active = true;
+    _reset();
+    for (const auto& span : _built.spans()) {
+        auto slot = _retain(std::string_view(span.word, span.len));
+        _count[slot] += span.count;
+        _peak = std::max(_peak, _count[slot] & ~WordIndex::FIXED);
+    }
+    for (const auto& it : _journal) {
+        _scan(it.first.c_str(), it.first.length(), -1);
+        _scan(it.second.c_str(), it.second.length(), 1);
+    }
+#ifdef DEBUG_EDITOR
+    printf("WordIndex::publish(%d words from %d bytes, %d in pool) in %u mS\n", (int) size(), (int) _length, (int) WordIndex::POOL.size(), (unsigned) (gnu::Time::Milli() - _time));
+    fflush(stdout);
+#endif
+    _built.release();
+    _journal.clear();
+    free(_text);
+    _length = 0;
+    _text   = nullptr;
+    return true;
+}
+void WordIndex::_release(unsigned slot) {
+    auto word = WordIndex::SLOTS[slot].word;
+    _count[slot] = 0;
+    _size--;
+    if (--word->second.refs > 0) {
+        return;
+    }
+    WordIndex::GARBAGE += WordIndex::SLOTS[slot].length;
+    WordIndex::KEYS[slot] = 0;
+    WordIndex::SLOTS[slot].word = nullptr;
+    WordIndex::POOL.erase(WordIndex::POOL.find(word->first));
+}
+void WordIndex::_reset() {
+    _peak = 0;
+    for (size_t f = 0; f < _count.size(); f++) {
+        if ((_count[f] & WordIndex::FIXED) != 0) {
+            _count[f] = WordIndex::FIXED;
+        }
+        else if (_count[f] != 0) {
+            _release(static_cast<unsigned>(f));
+        }
+    }
+    WordIndex::_Compact();
+}
+unsigned WordIndex::_retain(std::string_view word) {
+    auto it = WordIndex::POOL.find(std::string(word));
+    if (it == WordIndex::POOL.end()) {
+        auto slot = static_cast<unsigned>(WordIndex::SLOTS.size());
+        auto key  = WordIndex::Key(word.data(), word.length());
+        it = WordIndex::POOL.emplace(std::string(word), Entry{0, slot}).first;
+        WordIndex::KEYS.push_back(key);
+        WordIndex::SLOTS.push_back(Slot{&*it, static_cast<uint32_t>(WordIndex::TEXT.length()), static_cast<uint32_t>(word.length())});
+        WordIndex::TEXT.append(word.data(), word.length());
+        WordIndex::_Heads(slot, word, key);
+    }
+    auto slot = it->second.slot;
+    if (slot >= _count.size()) {
+        _count.resize(slot + 1);
+    }
+    if (_count[slot] == 0) {
+        it->second.refs++;
+        _size++;
+    }
+    return slot;
+}
+void WordIndex::_scan(const char* text, size_t len, int delta) {
+    auto start = text;
+    auto end   = text + len;
+    for (auto p = text; p <= end; p++) {
+        if (p < end && (_tokens.get(static_cast<uint8_t>(*p)) & Token::LETTER)) {
+            continue;
+        }
+        auto word_len = static_cast<size_t>(p - start);
+        if (word_len > 1 && word_len < limits::AUTOCOMPLETE_WORD_SIZE_VAL) {
+            auto slot = _find(std::string_view(start, word_len));
+            if (delta > 0 && slot == WordIndex::NONE && _size < limits::AUTOCOMPLETE_LINES_VAL) {
+                slot = _retain(std::string_view(start, word_len));
+            }
+            if (slot != WordIndex::NONE && delta > 0) {
+                _count[slot]++;
+                _peak = std::max(_peak, _count[slot] & ~WordIndex::FIXED);
+            }
+            else if (slot != WordIndex::NONE && _count[slot] == 1) {
+                _release(slot);
+            }
+            else if (slot != WordIndex::NONE && (_count[slot] & ~WordIndex::FIXED) > 0) {
+                _count[slot]--;
+            }
+        }
+        start = p + 1;
+    }
+    WordIndex::_Compact();
+}
+int WordIndex::Score(const char* query, size_t query_len, const char* word, size_t word_len) {
+    auto lower = [](uint8_t c) { return (c >= 'A' && c <= 'Z') ? c + 32 : c; };
+    auto head  = [word](size_t w) { return w == 0 || word[w - 1] == '_' || (word[w] >= 'A' && word[w] <= 'Z' && word[w - 1] >= 'a' && word[w - 1] <= 'z'); };
+    auto score = 0;
+    auto next  = (size_t) 0;
+    for (size_t q = 0; q < query_len; q++) {
+        auto c = lower(static_cast<uint8_t>(query[q]));
+        auto w = next;
+        while (w < word_len && (lower(static_cast<uint8_t>(word[w])) != c || (q == 0 && head(w) == false))) {
+            w++;
+        }
+        if (w == word_len) {
+            return -1;
+        }
+        else if (w == 0) {
+            score += 10;
+        }
+        else if (w == next && q > 0) {
+            score += 5;
+        }
+        else if (head(w) == true) {
+            score += 8;
+        }
+        else {
+            score -= 1;
+        }
+        if (word[w] == query[q]) {
+            score += 1;
+        }
+        next = w + 1;
+    }
+    return std::max(score - static_cast<int>(word_len - query_len) / 4, 0);
+}
+void WordIndex::ThreadFunc(WordIndex* self) {
+    auto scan = WordScanner(self->_text, self->_length);
+    auto word = (const char*) nullptr;
+    auto len  = (size_t) 0;
+    while (self->_cancel == false && scan.next(word, len) == true) {
+        if (len > 1 && len < limits::AUTOCOMPLETE_WORD_SIZE_VAL) {
+            self->_built.add(word, len, self->_built.size() < limits::AUTOCOMPLETE_LINES_VAL);
+        }
+    }
+    self->_done = true;
+}
+void WordIndex::update(TextBuffer& buffer, int pos, int inserted_size, int deleted_size, const char* deleted_text) {
+    if ((_active == false && _text == nullptr) || (inserted_size == 0 && deleted_size == 0)) {
+        return;
+    }
+    else if (pos == 0 && inserted_size == buffer.length() && inserted_size >= WordIndex::REBUILD) {
+        build(buffer.text(), buffer.length());
+        return;
+    }
+    else if (pos >= _limit) {
+        return;
+    }
+    auto limit = _limit;
+    if (_limit < INT_MAX) {
+        _limit = (pos + deleted_size > _limit) ? pos + inserted_size : _limit + inserted_size - deleted_size;
+    }
+    auto start = pos;
+    auto end   = pos + inserted_size;
+    while (start > 0 && (_tokens.get(buffer.peek(start - 1)) & Token::LETTER)) {
+        start--;
+    }
+    while (end < buffer.length() && (_tokens.get(buffer.peek(end)) & Token::LETTER)) {
+        end++;
+    }
+    auto text = buffer.get_range(start, end);
+    auto old  = text.substr(0, pos - start);
+    if (deleted_size > 0 && deleted_text != nullptr) {
+        old.append(deleted_text, deleted_size);
+    }
+    old.append(text, pos + inserted_size - start, std::string::npos);
+    if (limit < INT_MAX) {
+        old.resize(std::min(old.length(), static_cast<size_t>(limit - start)));
+        text.resize(std::min(text.length(), static_cast<size_t>(_limit - start)));
+    }
+    if (_active == true) {
+        _scan(old.c_str(), old.length(), -1);
+        _scan(text.c_str(), text.length(), 1);
+    }
+    if (_text != nullptr) {
+        _journal.emplace_back(std::move(old), std::move(text));
+    }
+}
 }
 #include <algorithm>
 #include <climits>
@@ -18157,30 +20138,47 @@ static bool _textbuffer_pair(char c, char& e, bool& forward) {
     }
     return true;
 }
-BufferController::BufferController(TextBuffer* buffer, int timeout, bool start_group_lock) {
-    _buffer  = buffer;
-    _running = false;
-    _stopped = false;
-    _time    = gnu::Time::Milli();
-    _timeout = timeout;
-    _wc      = nullptr;
+BufferController::BufferController(TextBuffer* buffer, int timeout, bool start_group_lock, const std::string& progress) {
+    _buffer    = buffer;
+    _cancelled = false;
+    _label     = progress;
+    _polls     = 0;
+    _progress  = nullptr;
+    _running   = false;
+    _stopped   = false;
+    _time      = gnu::Time::Milli();
+    _timeout   = timeout;
+    _wc        = nullptr;
     if (_buffer->_undo != nullptr && start_group_lock == true) {
         _buffer->_undo->group_lock();
     }
+    if (_buffer->_editor != nullptr) {
+        _buffer->_editor->matches_pause(true);
+    }
 }
-void BufferController::check_timeout() {
+bool BufferController::check_timeout(int pos) {
     auto ed = _buffer->_editor;
-    if (_running == true) {
-        return;
+    if (_cancelled == true) {
+        return false;
+    }
+    else if (_running == true) {
+        if (_progress != nullptr && ++_polls % BufferController::POLL == 0 && _progress->update(pos, gnu::str::format("%d of %d bytes", pos, _buffer->length()), 100) == false) {
+            _cancelled = true;
+        }
+        return _cancelled == false;
     }
     else if (_timeout != 0 && gnu::Time::Milli() - _time <= _timeout) {
-        return;
+        return true;
     }
     _wc      = new flw::WaitCursor();
     _running = true;
     if (ed != nullptr) {
         ed->style().pause(true);
     }
+    if (_label != "") {
+        _progress = new flw::dlg::Progress(_label, _buffer->_undo != nullptr, false, 0.0, std::max(_buffer->length(), 1));
+        _progress->start();
+    }
 #ifdef DEBUG_STYLE
     ::printf("BufferController::check_timeout: (ON)\n");
     ::printf("    timeout            = %d mS\n", (int) _timeout);
@@ -18188,6 +20186,17 @@ void BufferController::check_timeout() {
     ::printf("    _count_changes     = %d\n", (int) _buffer->count_changes());
     fflush(stdout);
 #endif
+    return true;
+}
+CursorPos BufferController::rollback(CursorPos cursor) {
+    auto changes = _buffer->count_changes();
+    stop();
+    if (changes > 0 && _buffer->_undo != nullptr) {
+        cursor = _buffer->undo(FUndoRange::ONE, cursor);
+    }
+    _buffer->_cancelled     = true;
+    _buffer->_count_changes = 0;
+    return cursor;
 }
 void BufferController::stop() {
     auto ed = _buffer->_editor;
@@ -18209,23 +20218,33 @@ void BufferController::stop() {
                 _buffer->_undo->group_unlock();
             }
         }
+        if (ed != nullptr) {
+            ed->matches_pause(false);
+        }
         _time = gnu::Time::Milli() - _time;
     }
+    delete _progress;
     delete _wc;
-    _wc = nullptr;
+    _progress = nullptr;
+    _wc       = nullptr;
 }
 int TextBuffer::TIMEOUT_LONG  = 200;
 int TextBuffer::TIMEOUT_SHORT =  50;
 int TextBuffer::TIMEOUT_UNDO  = 100;
 TextBuffer::TextBuffer(Editor* editor, Config& config) : Fl_Text_Buffer(4'096, 8'192), _config(config) {
+    _cancelled     = false;
     _count_changes = 0;
+    _diff_end      = -1;
+    _diff_start    = -1;
     _dirty         = false;
     _editor        = editor;
     _fdelkey       = FDelKey::NIL;
     _fundo         = FUndoMode::NONE;
     _hack_undo     = 0;
     _pause_undo    = false;
+    _revision      = 0;
     _style_text    = false;
+    _track_diff    = false;
     _undo          = nullptr;
     _word          = Token::MakeWord();
     undo_set_mode_using_config();
@@ -18258,7 +20277,17 @@ CursorPos TextBuffer::case_for_selection(FCase fcase) {
         free(buf);
         return CursorPos();
     }
+    if (_undo != nullptr) {
+        _undo->group_lock();
+        _undo->add_custom1(gnu::str::format("%d %d %d", cursor.pos1, cursor.start, cursor.end));
+    }
+    _undo_diff_begin();
     replace_selection(buf);
+    _undo_diff_end();
+    if (_undo != nullptr) {
+        _undo->add_custom1(gnu::str::format("%d %d %d", cursor.pos1, cursor.start, cursor.end));
+        _undo->group_unlock_and_add();
+    }
     free(text);
     free(buf);
     cursor.set_drag();
@@ -18306,11 +20335,18 @@ void TextBuffer::CallbackUndo(
             else {
                 added = buffer->_undo->add(buffer->_fdelkey, buffer->has_selection(), pos, inserted_text, inserted_size, deleted_text, deleted_size);
             }
+            if (added == undo::STATUS::ADDED && buffer->_undo->snapshot_due() == true) {
+                buffer->_undo_snapshot();
+            }
+        }
+        else if (buffer->_track_diff == true) {
+            buffer->_undo_diff_track(pos, inserted_size, deleted_size, deleted_text);
         }
     }
     buffer->_has_selection = false;
     buffer->clear_key();
     buffer->_count_changes++;
+    buffer->_revision++;
     if (editor != nullptr) {
         if (inserted_size != deleted_size) {
             editor->bookmarks().update(pos, inserted_size, deleted_size);
@@ -18407,11 +20443,11 @@ CursorPos TextBuffer::comment_line(const std::string& line_comment) {
     auto rx      = gnu::pcre8::PCRE(gnu::str::format("^\\s*(%s)", line_comment.c_str()));
     auto matches = rx.exec(line);
     if (matches.size() == 2) {
-        return _find_replace_regex_all(&rx, "", start2, end2, FRegexType::REPLACE, FSelection::NO, true);
+        return _find_replace_regex_all(&rx, "", start2, end2, FRegexType::REPLACE, FSelection::NO, FScope::ALL, true);
     }
     else {
         rx.compile("(^\\s*)(\\S+)");
-        return _find_replace_regex_all(&rx, line_comment, start2, end2, FRegexType::INSERT, FSelection::NO, true);
+        return _find_replace_regex_all(&rx, line_comment, start2, end2, FRegexType::INSERT, FSelection::NO, FScope::ALL, true);
     }
 }
 bool TextBuffer::cut_or_copy_line(int pos, FCopy fcopy) {
@@ -18565,72 +20601,343 @@ CursorPos TextBuffer::duplicate_text() {
         return tmp;
     }
 }
+std::string TextBuffer::edit_benchmark(Style* style) {
+    struct StyleData {
+        Style*                  style;
+        TextBuffer*             buffer;
+    };
+    auto before   = gnu::str::grab(text());
+    auto stylebuf = TextBuffer(nullptr, _config);
+    auto data     = StyleData{style, &stylebuf};
+    auto keys     = std::vector<int64_t>();
+    auto pastes   = std::vector<int64_t>();
+    auto peak     = (ssize_t) 0;
+    auto seed     = (uint32_t) 1;
+    auto pos      = length() / 2;
+    auto cursor   = CursorPos();
+    auto random   = [&seed](int max) { seed = seed * 1'103'515'245 + 12'345; return (max > 0) ? static_cast<int>((seed >> 8) % max) : 0; };
+    auto sample   = [this, &peak]() { if (_undo != nullptr) peak = std::max(peak, _undo->capacity()); };
+    auto callback = [](const int pos, const int inserted_size, const int deleted_size, const int, const char* deleted_text, void* o) {
+        auto data = static_cast<StyleData*>(o);
+        if (deleted_size > 0) {
+            data->buffer->remove(pos, pos + deleted_size);
+        }
+        if (inserted_size > 0) {
+            auto buffer = gnu::file::allocate(nullptr, inserted_size + 1);
+            memset(buffer, style::STYLE_INIT, inserted_size);
+            data->buffer->insert(pos, buffer);
+            free(buffer);
+        }
+        data->style->update(pos, inserted_size, deleted_size, deleted_text, nullptr, nullptr);
+    };
+    if (before.empty() == true) {
+        before = "flEdit\n";
+        set(before.c_str(), FChecksum::NO);
+        pos = 0;
+    }
+    if (style != nullptr && style->name() != style::TEXT) {
+        auto style1 = gnu::file::allocate(nullptr, length() + 1);
+        memset(style1, style::STYLE_INIT, length());
+        stylebuf.text(style1);
+        free(style1);
+        style->set_buffers(this, &stylebuf);
+        style->update(0, length(), 0, nullptr, nullptr, nullptr);
+        add_modify_callback(callback, &data);
+    }
+    callback_connect();
+    auto time1 = gnu::Time::Micro();
+    for (int f = 0; f < 20'000; f++) {
+        char key[2] = { before[f % before.length()], 0 };
+        auto time   = gnu::Time::Micro();
+        if (f % 16 == 15) {
+            set_backspace_key();
+            remove(pos - 1, pos);
+            pos--;
+        }
+        else {
+            insert(pos, key);
+            pos++;
+        }
+        keys.push_back(gnu::Time::Micro() - time);
+        if (f % 256 == 0) {
+            sample();
+        }
+    }
+    time1 = gnu::Time::Micro() - time1;
+    for (int f = 0; f < 200; f++) {
+        auto paste = before.substr(random(static_cast<int>(before.length())), 1 + random(4'096));
+        auto time  = gnu::Time::Micro();
+        insert(random(length() + 1), paste.c_str());
+        pastes.push_back(gnu::Time::Micro() - time);
+    }
+    sample();
+    auto time2 = gnu::Time::Milli();
+    for (const auto& find : { std::string(" "), std::string("XX") }) {
+        find_replace_all(find, (find == " ") ? "XX" : " ", FSelection::NO, FCaseCompare::YES, FWordCompare::NO, FNlTab::NO, FScope::ALL);
+        sample();
+    }
+    time2 = gnu::Time::Milli() - time2;
+    auto time3 = gnu::Time::Milli();
+    for (int f = 0; f < 500; f++) {
+        auto start1 = 0;
+        auto end1   = 0;
+        auto start2 = 0;
+        auto end2   = 0;
+        get_line_range(random(length()), start1, end1);
+        if (end1 >= length() - 1) {
+            continue;
+        }
+        auto line = get_range(start1, end1 + 1);
+        if (_undo != nullptr) {
+            _undo->group_lock();
+        }
+        remove(start1, end1 + 1);
+        get_line_range(start1, start2, end2);
+        if (peek(end2) != 10) {
+            insert(end2 + 1, "\n");
+        }
+        insert(end2 + 1, line.c_str());
+        if (_undo != nullptr) {
+            _undo->group_unlock_and_add();
+        }
+    }
+    time3 = gnu::Time::Milli() - time3;
+    sample();
+    auto after = gnu::str::grab(text());
+    auto time4 = gnu::Time::Milli();
+    undo(FUndoRange::ALL, cursor);
+    time4 = gnu::Time::Milli() - time4;
+    auto ok    = (_undo == nullptr || gnu::str::grab(text()) == before);
+    auto time5 = gnu::Time::Milli();
+    redo(FUndoRange::ALL, cursor);
+    time5 = gnu::Time::Milli() - time5;
+    ok = ok == true && (_undo == nullptr || gnu::str::grab(text()) == after);
+    callback_disconnect();
+    remove_modify_callback(callback, &data);
+    if (style != nullptr) {
+        style->set_buffers(nullptr, nullptr);
+    }
+    std::sort(keys.begin(), keys.end());
+    std::sort(pastes.begin(), pastes.end());
+    return gnu::str::format(
+        "%10d bytes| type: %7.0f keys/s p50 %4d p99 %5d max %6d uS| paste: p50 %5d p99 %6d max %7d uS| replace all: %5d mS| move lines: %5d mS| undo all: %5d mS| redo all: %5d mS| undo peak: %10lld bytes| %s",
+        static_cast<int>(before.length()),
+        keys.size() * 1'000'000.0 / std::max(time1, (int64_t) 1),
+        static_cast<int>(keys[keys.size() / 2]),
+        static_cast<int>(keys[keys.size() * 99 / 100]),
+        static_cast<int>(keys.back()),
+        static_cast<int>(pastes[pastes.size() / 2]),
+        static_cast<int>(pastes[pastes.size() * 99 / 100]),
+        static_cast<int>(pastes.back()),
+        static_cast<int>(time2),
+        static_cast<int>(time3),
+        static_cast<int>(time4),
+        static_cast<int>(time5),
+        static_cast<long long int>(peak),
+        (ok == true) ? "ok" : "FAILED"
+    );
+}
 size_t TextBuffer::find_lines(
     std::string                 filename,
     std::string                 find,
     gnu::pcre8::PCRE*           re,
+    const MultiSearch*          terms,
+    FScope                      fscope,
     FTrim                       ftrim,
-    std::vector<std::string>&   out) {
+    ResultStore&                out) {
     if (find == "" && re == nullptr) {
         return 0;
     }
     auto count = (size_t) 0;
-    for (auto f = 0; f < length();) {
-        auto line = gnu::str::grab(line_text(f));
-        auto col  = -1;
-        if (re == nullptr) {
-            auto found = strstr(line.c_str(), find.c_str());
-            col = (found != nullptr) ? static_cast<int>(static_cast<std::ptrdiff_t>(found - line.c_str())) : -1;
+    if (terms != nullptr || fscope != FScope::ALL) {
+        auto style = (const char*) nullptr;
+        if (_scope_style(fscope, style) == false) {
+            out.add((filename != "") ? gnu::str::format("Error: %s, skipped %s", info::NOT_STYLED.c_str(), filename.c_str()) : "Error: " + info::NOT_STYLED);
+            return 0;
         }
-        else {
-            auto matches = re->exec(line);
-            if (matches.size() > 0) {
-                col = matches.back().start();
+        return TextBuffer::FindLines(filename, _contiguous(), length(), find, re, terms, style, fscope, ftrim, out);
+    }
+    else if (re == nullptr) {
+        auto search = LiteralSearch(find, true);
+        auto row    = 0;
+        auto prev   = 0;
+        auto pos    = 0;
+        while (search_literal(search, pos, FSearchDir::FORWARD, pos) == true) {
+            auto start = line_start(pos);
+            auto end   = line_end(pos);
+            row += count_lines(prev, start);
+            auto line = get_range(start, end);
+            if (TextBuffer::AddFoundLine(filename, row, pos - start, line.c_str(), static_cast<int>(line.length()), ftrim, out) == false) {
+                break;
             }
+            count++;
+            prev = start;
+            pos  = end + 1;
+        }
+        return count;
+    }
+    auto row = 0;
+    auto off = std::vector<int>();
+    for (auto f = 0; f < length(); row++) {
+        auto line = gnu::str::grab(line_text(f));
+        auto res  = re->exec_offsets(line.c_str(), line.length(), off);
+        auto col  = -1;
+        for (auto i = res - 1; i >= 0 && col < 0; i--) {
+            col = off[i * 2];
         }
         if (col >= 0) {
-            if (out.size() < limits::OUTPUT_LINES_VAL) {
-                std::string s;
-                if (ftrim == FTrim::YES) {
-                    auto trimmed = line;
-                    gnu::str::trim(trimmed);
-                    if (filename != "") {
-                        s = gnu::str::format("%s: %6d - %4d| %s", filename.c_str(), count + 1, col + 1, trimmed.c_str());
-                    }
-                    else {
-                        s = gnu::str::format("%6d - %4d| %s", count + 1, col + 1, trimmed.c_str());
-                    }
-                }
-                else if (filename != "") {
-                    s = gnu::str::format("%s: %6d - %4d| %s", filename.c_str(), count + 1, col + 1, line.c_str());
-                }
-                else  {
-                    s = gnu::str::format("%6d - %4d| %s", count + 1, col + 1, line.c_str());
-                }
-                if (s.length() > fle::limits::OUTPUT_LINE_LENGTH_VAL) {
-                    s.resize(fle::limits::OUTPUT_LINE_LENGTH_VAL);
-                    s += "|";
-                }
-                out.push_back(s);
-            }
-            else {
-                out.push_back("Error: max number of lines has been reached!");
+            if (TextBuffer::AddFoundLine(filename, row, col, line.c_str(), static_cast<int>(line.length()), ftrim, out) == false) {
                 break;
             }
+            count++;
         }
-        count++;
         f += line.length();
         f++;
     }
     return count;
 }
-CursorPos TextBuffer::find_replace(
+int TextBuffer::FindAll(const char* text, int text_len, const char* style, int from, int to, const std::string& find, FCaseCompare fcase, FWordCompare fword, FScope fscope, std::vector<int>& out, const std::atomic<bool>* cancel) {
+    auto search = LiteralSearch(find, fcase == FCaseCompare::YES);
+    auto word   = Token::MakeWord();
+    auto len    = static_cast<int>(find.length());
+    auto type   = Token::NIL;
+    auto pos    = std::max(from, 0);
+    out.clear();
+    if (find == "" || text == nullptr) {
+        return 0;
+    }
+    else if (fword == FWordCompare::YES) {
+        for (auto c : find) {
+            auto t = word.get(static_cast<uint8_t>(c));
+            if (type == Token::NIL) {
+                type = t;
+            }
+            else if (t != type) {
+                type = Token::NIL;
+                break;
+            }
+        }
+        if (type != Token::LETTER) {
+            return 0;
+        }
+    }
+    to = std::min(to, text_len);
+    while ((cancel == nullptr || *cancel == false) && (pos = search.find(text, to, pos)) >= 0) {
+        auto skip = false;
+        if (type != Token::NIL) {
+            auto pt = word.get((pos > 0) ? static_cast<uint8_t>(text[pos - 1]) : 0);
+            auto nt = word.get((pos + len < text_len) ? static_cast<uint8_t>(text[pos + len]) : 0);
+            skip = (pt == type || nt == type);
+        }
+        if (skip == false && style != nullptr && TextBuffer::InScope(style[pos], fscope) == false) {
+            skip = true;
+        }
+        if (skip == false) {
+            out.push_back(pos);
+        }
+        pos += len;
+    }
+    return static_cast<int>(out.size());
+}
+size_t TextBuffer::FindLines(
+    const std::string&          filename,
+    const char*                 text,
+    int                         text_len,
+    const std::string&          find,
+    const gnu::pcre8::PCRE*     re,
+    const MultiSearch*          terms,
+    const char*                 style,
+    FScope                      fscope,
+    FTrim                       ftrim,
+    ResultStore&                out,
+    const std::atomic<bool>*    cancel) {
+    if ((find == "" && re == nullptr) || text == nullptr) {
+        return 0;
+    }
+    auto count = (size_t) 0;
+    auto row   = 0;
+    auto prev  = 0;
+    auto pos   = 0;
+    if (re == nullptr) {
+        auto search = LiteralSearch(find, true);
+        while ((pos = (terms != nullptr) ? terms->find(text, text_len, pos) : search.find(text, text_len, pos)) >= 0) {
+            if (style != nullptr && TextBuffer::InScope(style[pos], fscope) == false) {
+                pos++;
+                continue;
+            }
+            auto start = pos;
+            auto end   = static_cast<const char*>(memchr(text + pos, '\n', text_len - pos));
+            auto stop  = (end == nullptr) ? text_len : static_cast<int>(end - text);
+            while (start > 0 && text[start - 1] != '\n') {
+                start--;
+            }
+            row += static_cast<int>(std::count(text + prev, text + start, '\n'));
+            if ((cancel != nullptr && *cancel == true) || TextBuffer::AddFoundLine(filename, row, pos - start, text + start, stop - start, ftrim, out) == false) {
+                break;
+            }
+            count++;
+            prev = start;
+            pos  = stop + 1;
+        }
+        return count;
+    }
+    auto off = std::vector<int>();
+    while (pos < text_len) {
+        auto end  = static_cast<const char*>(memchr(text + pos, '\n', text_len - pos));
+        auto stop = (end == nullptr) ? text_len : static_cast<int>(end - text);
+        auto res   = re->exec_offsets(text + pos, stop - pos, off);
+        auto col   = -1;
+        auto start = 0;
+        while (res > 0) {
+            for (auto i = res - 1; i >= 0 && col < 0; i--) {
+                col = off[i * 2];
+            }
+            if (col < 0 || style == nullptr || TextBuffer::InScope(style[pos + col], fscope) == true) {
+                break;
+            }
+            col   = -1;
+            start = std::max(off[1], start + 1);
+            res   = (start <= stop - pos) ? re->exec_offsets(text + pos, stop - pos, off, start) : 0;
+        }
+        if (cancel != nullptr && *cancel == true) {
+            break;
+        }
+        else if (col >= 0) {
+            if (TextBuffer::AddFoundLine(filename, row, col, text + pos, stop - pos, ftrim, out) == false) {
+                break;
+            }
+            count++;
+        }
+        row++;
+        pos = stop + 1;
+    }
+    return count;
+}
+bool TextBuffer::AddFoundLine(const std::string& filename, int row, int col, const char* line, int len, FTrim ftrim, ResultStore& out) {
+    if (limits::OUTPUT_LINES_VAL > 0 && out.size() >= limits::OUTPUT_LINES_VAL) {
+        out.add("Error: max number of lines has been reached!");
+        return false;
+    }
+    if (ftrim == FTrim::YES) {
+        while (len > 0 && std::isspace(static_cast<unsigned char>(*line)) != 0) {
+            line++;
+            len--;
+        }
+        while (len > 0 && std::isspace(static_cast<unsigned char>(line[len - 1])) != 0) {
+            len--;
+        }
+    }
+    out.add(filename, row + 1, col + 1, line, len);
+    return true;
+}
+CursorPos TextBuffer::find_replace(
     std::string     find,
     const char*     replace,
     FSearchDir      fsearchdir,
     FCaseCompare    fcasecompare,
     FWordCompare    fwordcompare,
-    FNlTab          fnltab
+    FNlTab          fnltab,
+    FScope          fscope
     ) {
     _count_changes = 0;
     auto replace2 = gnu::str::to_string(replace);
@@ -18644,13 +20951,14 @@ CursorPos TextBuffer::find_replace(
     auto start       = 0;
     auto end         = 0;
     auto type        = (fwordcompare == FWordCompare::YES) ? _token(find) : Token::NIL;
+    auto search      = LiteralSearch(find, fcasecompare == FCaseCompare::YES);
     auto loop        = 0;
     auto sel         = selection_position(&start, &end) != 0;
     if (find == "" || find_len > length() || (fwordcompare == FWordCompare::YES && type != Token::LETTER)) {
         return CursorPos();
     }
     if (replace != nullptr && sel == true) {
-        if (fwordcompare == FWordCompare::NO || _is_word(start, start + find_len, type) == true) {
+        if ((fwordcompare == FWordCompare::NO || _is_word(start, start + find_len, type) == true) && _in_scope(start, fscope) == true) {
             auto text = get_selection_text();
             if ((fcasecompare == FCaseCompare::YES && fl_utf_strcasecmp(text.c_str(), find.c_str()) == 0) ||
                 (fcasecompare == FCaseCompare::NO && fl_utf_strncasecmp(text.c_str(), find.c_str(), find.length()) == 0)) {
@@ -18680,16 +20988,16 @@ CursorPos TextBuffer::find_replace(
             cursor.pos1 = (fsearchdir == FSearchDir::FORWARD) ? 0 : length() - 1;
         }
         if (fsearchdir == FSearchDir::FORWARD) {
-            while (found == false && search_forward(cursor.pos1, find.c_str(), &find_pos, fcasecompare == FCaseCompare::YES) != 0) {
-                found = (fwordcompare == FWordCompare::NO || _is_word(find_pos, find_pos + find_len, type) == true);
+            while (found == false && search_literal(search, cursor.pos1, FSearchDir::FORWARD, find_pos) == true) {
+                found = (fwordcompare == FWordCompare::NO || _is_word(find_pos, find_pos + find_len, type) == true) && _in_scope(find_pos, fscope) == true;
                 if (found == false) {
                     cursor.pos1 = find_pos + find_len;
                 }
             }
         }
         else if (fsearchdir == FSearchDir::BACKWARD) {
-            while (found == false && cursor.pos1 >= 0 && search_backward(cursor.pos1, find.c_str(), &find_pos, fcasecompare == FCaseCompare::YES) != 0) {
-                found = (fwordcompare == FWordCompare::NO || _is_word(find_pos, find_pos + find_len, type) == true);
+            while (found == false && cursor.pos1 >= 0 && search_literal(search, cursor.pos1, FSearchDir::BACKWARD, find_pos) == true) {
+                found = (fwordcompare == FWordCompare::NO || _is_word(find_pos, find_pos + find_len, type) == true) && _in_scope(find_pos, fscope) == true;
                 if (found == false) {
                     cursor.pos1 = find_pos - find_len;
                 }
@@ -18715,30 +21023,32 @@ CursorPos TextBuffer::find_replace_all(
     FSelection      fselection,
     FCaseCompare    fcase,
     FWordCompare    fword,
-    FNlTab          fnltab) {
+    FNlTab          fnltab,
+    FScope          fscope) {
+    _cancelled     = false;
     _count_changes = 0;
     find    = (fnltab == FNlTab::YES || fnltab == FNlTab::FIND) ? string::fnltab(find) : find;
     replace = (fnltab == FNlTab::YES || fnltab == FNlTab::REPLACE) ? string::fnltab(replace) : replace;
-    auto cursor     = _editor->cursor(true);
-    auto ctrl       = BufferController(this, TextBuffer::TIMEOUT_LONG, true);
-    auto type       = (fword == FWordCompare::YES) ? _token(find) : Token::NIL;
-    auto inside_sel = false;
-    auto pos        = 0;
-    if (find == "") {
+    auto cursor = (_editor != nullptr) ? _editor->cursor(true) : CursorPos();
+    auto ctrl   = BufferController(this, TextBuffer::TIMEOUT_LONG, true, "Replace All");
+    auto style  = (const char*) nullptr;
+    auto found  = std::vector<int>();
+    auto from   = 0;
+    auto to     = length();
+    auto move   = static_cast<int>(replace.length()) - static_cast<int>(find.length());
+    auto moved  = 0;
+    if (_scope_style(fscope, style) == false) {
         return CursorPos();
     }
-    else if (static_cast<int>(find.length()) > length()) {
-        return CursorPos();
-    }
-    else if (fword == FWordCompare::YES && type != Token::LETTER) {
-        return CursorPos();
-    }
-    if (fselection == FSelection::YES) {
+    else if (fselection == FSelection::YES) {
         if (cursor.text_has_selection() == false) {
             return CursorPos();
         }
-        pos        = cursor.start;
-        inside_sel = true;
+        from = cursor.start;
+        to   = cursor.end;
+    }
+    if (TextBuffer::FindAll(_contiguous(), length(), style, from, to, find, fcase, fword, fscope, found) == 0) {
+        return CursorPos();
     }
     if (_undo != nullptr) {
         if (cursor.text_has_selection() == true) {
@@ -18748,46 +21058,31 @@ CursorPos TextBuffer::find_replace_all(
             _undo->prepare_custom1(gnu::str::format("%d -1 -1", cursor.pos1));
         }
     }
-    while (search_forward(pos, find.c_str(), &pos, fcase == FCaseCompare::YES) != 0) {
-        auto do_replace = true;
-        if (inside_sel == true && (pos + (int) find.length()) > cursor.end) {
-            break;
+    _undo_diff_begin();
+    for (auto start : found) {
+        auto pos = start + moved;
+        if (pos < cursor.pos1) {
+            cursor.pos1 += move;
         }
-        if (fword == FWordCompare::YES && type != Token::NIL) {
-            int word_end = pos + (int) find.length();
-            if (inside_sel == false || word_end <= cursor.end) {
-                int pt = _peek_token(pos - 1);
-                int nt = _peek_token(pos + find.length());
-                if (pt == type || nt == type) {
-                    do_replace = false;
-                }
-            }
+        if (pos < cursor.pos2) {
+            cursor.pos2 += move;
         }
-        if (do_replace == true) {
-            auto move = replace.length() - find.length();
-            if (pos < cursor.pos1) {
-                cursor.pos1 += move;
-            }
-            if (pos < cursor.pos2) {
-                cursor.pos2 += move;
+        if (cursor.text_has_selection() == true) {
+            if (pos < cursor.start) {
+                cursor.start += move;
             }
-            if (cursor.text_has_selection() == true) {
-                if (pos < cursor.start) {
-                    cursor.start += move;
-                }
-                if (pos < cursor.end) {
-                    cursor.end += move;
-                }
+            if (pos < cursor.end) {
+                cursor.end += move;
             }
-            assert(pos <= length() && pos + (int) find.length() <= length());
-            this->replace(pos, pos + find.length(), replace.c_str());
-            pos += replace.length();
         }
-        else {
-            pos += find.length();
+        assert(pos <= length() && pos + (int) find.length() <= length());
+        this->replace(pos, pos + find.length(), replace.c_str());
+        moved += move;
+        if (ctrl.check_timeout(pos + static_cast<int>(replace.length())) == false) {
+            break;
         }
-        ctrl.check_timeout();
     }
+    _undo_diff_end();
     if (_undo != nullptr) {
         _undo->clear_custom1();
         if (_count_changes == 0) {
@@ -18803,10 +21098,13 @@ CursorPos TextBuffer::find_replace_all(
     else if (_count_changes == 0) {
         return CursorPos();
     }
+    if (ctrl.cancelled() == true) {
+        return ctrl.rollback(cursor);
+    }
     cursor.set_drag();
     return cursor;
 }
-CursorPos TextBuffer::find_replace_regex(const std::string& find, const char* replace, FNlTab fnltab) {
+CursorPos TextBuffer::find_replace_regex(const std::string& find, const char* replace, FNlTab fnltab, FScope fscope) {
     _count_changes = 0;
     auto rx = gnu::pcre8::PCRE();
     if (rx.compile(find, true) != "") {
@@ -18836,7 +21134,7 @@ CursorPos TextBuffer::find_replace_regex(const std::string& find, const char* re
     if (sel == true && line_i < line_c && replace != nullptr) {
         auto matches = rx.notbol(line_i > 0).exec(line.c_str() + line_i);
         auto sub     = std::string();
-        if (matches.size() > 0 && sel_c == matches.front().count()) {
+        if (matches.size() > 0 && sel_c == matches.front().count() && _in_scope(sel_s, fscope) == true) {
             if (use_cap == true) {
                 sub = gnu::pcre8::Match::ReplaceDollar(matches, replace2);
                 replace_selection(sub.c_str());
@@ -18859,7 +21157,11 @@ CursorPos TextBuffer::find_replace_regex(const std::string& find, const char* re
     while (true) {
         if (line_i < line_c) {
             auto matches = rx.notbol(line_i > 0).exec(line.c_str() + line_i);
-            if (matches.size() > 0) {
+            if (matches.size() > 0 && _in_scope(line_s + line_i + matches.front().start(), fscope) == false) {
+                line_i += matches.front().start() + 1;
+                continue;
+            }
+            else if (matches.size() > 0) {
                 auto res  = _editor->cursor(false);
                 res.pos1  = line_s + line_i + matches.front().end();
                 res.start = line_s + line_i + matches.front().start();
@@ -18896,18 +21198,22 @@ CursorPos TextBuffer::_find_replace_regex_all(
     int                 to,
     FRegexType          fregextype,
     FSelection          fselection,
+    FScope              fscope,
     bool                last) {
     _count_changes = 0;
     if (to == 0) {
         to = length();
     }
     auto cursor  = _editor->cursor(true);
-    auto ctrl    = BufferController(this, TextBuffer::TIMEOUT_LONG, true);
+    auto ctrl    = BufferController(this, TextBuffer::TIMEOUT_LONG, true, (fregextype == FRegexType::REPLACE) ? "Replace All" : "");
     auto pos1    = from;
     auto start   = 0;
     auto end     = 0;
     auto use_cap = gnu::pcre8::PCRE::Find("\\$\\d", replace);
-    if (fselection == FSelection::YES) {
+    if (has_scope_style(fscope) == false) {
+        return CursorPos();
+    }
+    else if (fselection == FSelection::YES) {
         from = cursor.start;
         to   = cursor.end;
         pos1 = from;
@@ -18923,6 +21229,7 @@ CursorPos TextBuffer::_find_replace_regex_all(
             _undo->prepare_custom1(gnu::str::format("%d -1 -1", cursor.pos1));
         }
     }
+    _undo_diff_begin();
     while (pos1 < to) {
         auto notbol = false;
         auto noteol = false;
@@ -18947,8 +21254,12 @@ CursorPos TextBuffer::_find_replace_regex_all(
             auto re   = (last == true) ? matches.back().end() : matches.front().end();
             auto add  = 0;
             auto pos2 = 0;
+            auto skip = _in_scope(start + rs, fscope) == false;
             notbol    = true;
-            if (fregextype == FRegexType::REPLACE) {
+            if (skip == true) {
+                pos2 = start + rs;
+            }
+            else if (fregextype == FRegexType::REPLACE) {
                 auto sub = std::string();
                 if (use_cap == true) {
                     sub = gnu::pcre8::Match::ReplaceDollar(matches, replace);
@@ -19007,11 +21318,11 @@ CursorPos TextBuffer::_find_replace_regex_all(
         }
         free(org);
         pos1 = end + 1;
-        ctrl.check_timeout();
-        if (noteol == true) {
+        if (ctrl.check_timeout(pos1) == false || noteol == true) {
             break;
         }
     }
+    _undo_diff_end();
     if (_undo != nullptr) {
         if (_count_changes == 0) {
             _undo->clear_custom1();
@@ -19027,11 +21338,15 @@ CursorPos TextBuffer::_find_replace_regex_all(
     else if (_count_changes == 0) {
         return cursor;
     }
+    if (ctrl.cancelled() == true) {
+        return ctrl.rollback(cursor);
+    }
     cursor.set_drag();
     return cursor;
 }
-CursorPos TextBuffer::find_replace_regex_all(gnu::pcre8::PCRE* regex, std::string replace, FSelection fselection, FNlTab fnltab) {
+CursorPos TextBuffer::find_replace_regex_all(gnu::pcre8::PCRE* regex, std::string replace, FSelection fselection, FNlTab fnltab, FScope fscope) {
     assert(regex);
+    _cancelled     = false;
     _count_changes = 0;
     replace = (fnltab == FNlTab::YES || fnltab == FNlTab::REPLACE) ? string::fnltab(replace) : replace;
     auto cursor = _editor->cursor(false);
@@ -19039,10 +21354,10 @@ CursorPos TextBuffer::find_replace_regex_all(gnu::pcre8::PCRE* regex, std::strin
         if (cursor.text_has_selection() == false) {
             return cursor;
         }
-        return _find_replace_regex_all(regex, replace, cursor.start, cursor.end, FRegexType::REPLACE, FSelection::YES);
+        return _find_replace_regex_all(regex, replace, cursor.start, cursor.end, FRegexType::REPLACE, FSelection::YES, fscope);
     }
     else {
-        return _find_replace_regex_all(regex, replace, 0, length(), FRegexType::REPLACE, FSelection::NO);
+        return _find_replace_regex_all(regex, replace, 0, length(), FRegexType::REPLACE, FSelection::NO, fscope);
     }
 }
 gnu::file::Buf TextBuffer::get(FLineEnding flineending, FTrim ftrim, FChecksum fchecksum) {
@@ -19146,6 +21461,9 @@ bool TextBuffer::has_multiline_selection() {
     int s, e;
     return selection_position(&s, &e) != 0 && (line_end(s) < e || line_start(e) > s);
 }
+bool TextBuffer::has_scope_style(FScope fscope) const {
+    return fscope == FScope::ALL || (_editor != nullptr && _editor->style_buffer().length() == length());
+}
 int TextBuffer::home(int pos) {
     auto line = line_text(pos);
     if (*line == 0) {
@@ -19170,6 +21488,30 @@ int TextBuffer::home(int pos) {
         return start;
     }
 }
+bool TextBuffer::_in_scope(int pos, FScope fscope) const {
+    if (fscope == FScope::ALL || _editor == nullptr) {
+        return true;
+    }
+    auto& style = _editor->style_buffer();
+    if (style.length() != length() || pos < 0 || pos >= length()) {
+        return true;
+    }
+    return TextBuffer::InScope(style.peek(pos), fscope);
+}
+bool TextBuffer::InScope(char style, FScope fscope) {
+    auto comment = (style == style::STYLE_COMMENT || style == style::STYLE_BLOCK_COMMENT);
+    auto string  = (style == style::STYLE_STRING || style == style::STYLE_RAW_STRING);
+    if (fscope == FScope::CODE) {
+        return comment == false && string == false;
+    }
+    else if (fscope == FScope::COMMENTS) {
+        return comment;
+    }
+    else if (fscope == FScope::STRINGS) {
+        return string;
+    }
+    return true;
+}
 CursorPos TextBuffer::indent(FIndent findent) {
     _count_changes = 0;
     if (_config.pref_indentation != true || selected() != 0) {
@@ -19404,6 +21746,89 @@ CursorPos TextBuffer::move_text_left_or_right(CursorPos cursor, FMoveH fmoveh, F
     cursor.set_drag();
     return cursor;
 }
+bool TextBuffer::_scope_style(FScope fscope, const char*& style) {
+    style = nullptr;
+    if (fscope == FScope::ALL) {
+        return true;
+    }
+    else if (has_scope_style(fscope) == false) {
+        return false;
+    }
+    style = _editor->style_buffer()._contiguous();
+    return true;
+}
+std::string TextBuffer::search_benchmark(const std::string& find, bool match_case) const {
+    auto search = LiteralSearch(find, match_case);
+    auto count1 = 0;
+    auto count2 = 0;
+    auto pos    = 0;
+    auto time1  = gnu::Time::Milli();
+    while (find != "" && search_forward(pos, find.c_str(), &pos, match_case) != 0) {
+        count1++;
+        pos += find.length();
+    }
+    time1 = gnu::Time::Milli() - time1;
+    pos   = 0;
+    auto time2 = gnu::Time::Milli();
+    while (search_literal(search, pos, FSearchDir::FORWARD, pos) == true) {
+        count2++;
+        pos += search.length();
+    }
+    time2 = gnu::Time::Milli() - time2;
+    return gnu::str::format("%10d bytes| search_forward: %7d in %5d mS| search_literal: %7d in %5d mS", length(), count1, (int) time1, count2, (int) time2);
+}
+bool TextBuffer::search_literal(const LiteralSearch& search, int start, FSearchDir fsearchdir, int& found) const {
+    auto len = search.length();
+    auto res = -1;
+    if (len == 0 || len > mLength) {
+        return false;
+    }
+    else if (search.is_fast() == false && fsearchdir == FSearchDir::FORWARD) {
+        return search_forward(start, search.find_string().c_str(), &found, search.match_case()) != 0;
+    }
+    else if (search.is_fast() == false) {
+        return search_backward(start, search.find_string().c_str(), &found, search.match_case()) != 0;
+    }
+    auto gap   = mGapStart;
+    auto tail  = mBuf + mGapEnd;
+    auto w0    = std::max(0, gap - len + 1);
+    auto w1    = std::min(mLength, gap + len - 1);
+    if (fsearchdir == FSearchDir::FORWARD) {
+        start = std::max(start, 0);
+        if (start < gap) {
+            res = search.find(mBuf, gap, start);
+        }
+        w0 = std::max(start, w0);
+        if (res < 0 && w0 < gap && w1 - w0 >= len) {
+            auto window = get_range(w0, w1);
+            res = search.find(window.c_str(), static_cast<int>(window.length()), 0);
+            res = (res < 0) ? -1 : res + w0;
+        }
+        if (res < 0) {
+            res = search.find(tail, mLength - gap, std::max(start - gap, 0));
+            res = (res < 0) ? -1 : res + gap;
+        }
+    }
+    else if (start >= 0) {
+        if (start >= gap) {
+            res = search.rfind(tail, mLength - gap, start - gap);
+            res = (res < 0) ? -1 : res + gap;
+        }
+        if (res < 0 && w0 <= start && w0 < gap && w1 - w0 >= len) {
+            auto window = get_range(w0, w1);
+            res = search.rfind(window.c_str(), static_cast<int>(window.length()), std::min(start, gap - 1) - w0);
+            res = (res < 0) ? -1 : res + w0;
+        }
+        if (res < 0) {
+            res = search.rfind(mBuf, gap, std::min(start, gap - 1));
+        }
+    }
+    if (res < 0) {
+        return false;
+    }
+    found = res;
+    return true;
+}
 CursorPos TextBuffer::select_color() {
     auto  cursor  = _editor->cursor(false);
     auto& style   = _editor->style_buffer();
@@ -19552,6 +21977,7 @@ void TextBuffer::set(const char* text, FChecksum fchecksum) {
     if (_undo != nullptr) {
         _undo->clear();
         this->text(text);
+        _undo_snapshot();
     }
     else {
         this->text(text);
@@ -19571,21 +21997,40 @@ void TextBuffer::set_dirty(bool value, bool force_send) {
         _config.send_message(message::TEXT_CHANGED, "", "", _editor);
     }
 }
+void TextBuffer::set_save_point(char* text) {
+    if (_undo == nullptr) {
+        free(text);
+        return;
+    }
+    _undo->set_save_point();
+    _undo->break_append();
+    _undo_snapshot(text);
+}
 CursorPos TextBuffer::redo(FUndoRange fundocount, CursorPos cursor) {
     if (_undo == nullptr) {
         return cursor;
     }
-    auto node = _undo->redo();
+    auto node = undo::Event();
+    auto last = undo::Event();
     auto c    = 0;
     _count_changes = 0;
-    if (node.is_null() == true) {
-        return cursor;
+    if (fundocount == FUndoRange::ALL || (fundocount == FUndoRange::SAVEPOINT && _checksum != "")) {
+        c = _undo_jump((fundocount == FUndoRange::ALL) ? SSIZE_MAX : _undo->save_point(), false, cursor);
     }
-    else if (fundocount == FUndoRange::SAVEPOINT && _checksum == "") {
-        return cursor;
+    if (c > 0) {
+        last = _undo->peek_undo().event();
+        node = (fundocount == FUndoRange::SAVEPOINT && undo_check_save_point() == true) ? undo::Event() : _undo->redo();
+    }
+    else {
+        node = _undo->redo();
+        if (node.is_null() == true) {
+            return cursor;
+        }
+        else if (fundocount == FUndoRange::SAVEPOINT && _checksum == "") {
+            return cursor;
+        }
     }
     auto ctrl = BufferController(this, TextBuffer::TIMEOUT_UNDO, false);
-    auto last = undo::Event();
     _pause_undo = true;
     while (node.is_null() == false) {
         last     = node;
@@ -19594,7 +22039,7 @@ CursorPos TextBuffer::redo(FUndoRange fundocount, CursorPos cursor) {
         int len2 = node.len2();
         if (node.is_insert() == true) {
             c++;
-            insert(node.pos(), node.c_str1());
+            insert(node.pos(), node.c_str1(), len1);
             if (pos < cursor.pos1) {
                 cursor.pos1 += len1;
             }
@@ -19615,7 +22060,7 @@ CursorPos TextBuffer::redo(FUndoRange fundocount, CursorPos cursor) {
         else if (node.is_replace() == true) {
             c++;
             remove(node.pos(), node.pos() + len1);
-            insert(node.pos(), node.c_str2());
+            insert(node.pos(), node.c_str2(), len2);
             if (pos < cursor.pos1) {
                 cursor.pos1 -= len1;
                 cursor.pos1 += len2;
@@ -19625,6 +22070,10 @@ CursorPos TextBuffer::redo(FUndoRange fundocount, CursorPos cursor) {
                 cursor.pos2 += len2;
             }
         }
+        else if (node.is_diff() == true) {
+            c++;
+            _undo_diff(node, false, cursor);
+        }
         auto p = _undo->peek_redo();
         if (p.is_null() == false && (p.group() == node.group() || fundocount == FUndoRange::ALL || (fundocount == FUndoRange::SAVEPOINT && undo_check_save_point() == false))) {
             node = _undo->redo();
@@ -19640,6 +22089,80 @@ CursorPos TextBuffer::redo(FUndoRange fundocount, CursorPos cursor) {
     _count_changes = c;
     return cursor;
 }
+int TextBuffer::ReplaceAll(
+    const char*                 text,
+    int                         text_len,
+    const char*                 style,
+    std::string                 find,
+    std::string                 replace,
+    FRegex                      fregex,
+    FCaseCompare                fcase,
+    FWordCompare                fword,
+    FNlTab                      fnltab,
+    FScope                      fscope,
+    std::string&                out,
+    const std::atomic<bool>*    cancel) {
+    auto count = 0;
+    auto last  = 0;
+    auto pos   = 0;
+    find    = (fregex == FRegex::NO && (fnltab == FNlTab::YES || fnltab == FNlTab::FIND)) ? string::fnltab(find) : find;
+    replace = (fnltab == FNlTab::YES || fnltab == FNlTab::REPLACE) ? string::fnltab(replace) : replace;
+    out.clear();
+    if (find == "" || text == nullptr) {
+        return 0;
+    }
+    else if (fregex == FRegex::NO) {
+        auto found = std::vector<int>();
+        TextBuffer::FindAll(text, text_len, style, 0, text_len, find, fcase, fword, fscope, found, cancel);
+        for (auto start : found) {
+            out.append(text + last, start - last);
+            out += replace;
+            last = start + static_cast<int>(find.length());
+            count++;
+        }
+    }
+    else {
+        auto rx      = gnu::pcre8::PCRE(find, true);
+        auto use_cap = gnu::pcre8::PCRE::Find("\\$\\d", replace);
+        if (rx.is_compiled() == false) {
+            return 0;
+        }
+        while ((cancel == nullptr || *cancel == false) && pos < text_len) {
+            auto end     = static_cast<const char*>(memchr(text + pos, '\n', text_len - pos));
+            auto stop    = (end == nullptr) ? text_len : static_cast<int>(end - text);
+            auto line    = std::string(text + pos, stop - pos);
+            auto off     = 0;
+            auto matches = rx.notbol(false).noteol(false).exec(line);
+            while (matches.size() > 0) {
+                auto rs = matches.front().start();
+                auto re = matches.front().end();
+                if (style == nullptr || TextBuffer::InScope(style[pos + off + rs], fscope) == true) {
+                    out.append(text + last, pos + off + rs - last);
+                    out += (use_cap == true) ? gnu::pcre8::Match::ReplaceDollar(matches, replace) : replace;
+                    last = pos + off + re;
+                    count++;
+                }
+                if (re == 0) {
+                    re = 1;
+                }
+                off += re;
+                if (off > static_cast<int>(line.length())) {
+                    break;
+                }
+                matches = rx.notbol(true).noteol(false).exec(line.c_str() + off);
+            }
+            pos = stop + 1;
+        }
+    }
+    if (cancel != nullptr && *cancel == true) {
+        out.clear();
+        return 0;
+    }
+    else if (count > 0) {
+        out.append(text + last, text_len - last);
+    }
+    return count;
+}
 CursorPos TextBuffer::sort(FSort order) {
     _count_changes = 0;
     auto cursor = _editor->cursor(false);
@@ -19680,7 +22203,9 @@ CursorPos TextBuffer::sort(FSort order) {
         _undo->group_lock();
         _undo->add_custom1(gnu::str::format("%d %d %d", cursor.pos1, cursor.start, cursor.end));
     }
+    _undo_diff_begin();
     replace(start2, end2, sorted.c_str());
+    _undo_diff_end();
     if (_undo != nullptr) {
         _undo->prepare_custom1(gnu::str::format("%d %d %d", start2, start2, end2));
         _undo->group_unlock_and_add();
@@ -19692,6 +22217,42 @@ CursorPos TextBuffer::sort(FSort order) {
     cursor.set_drag();
     return cursor;
 }
+CursorPos TextBuffer::swap_text(const std::string& text) {
+    _count_changes = 0;
+    auto cursor = _editor->cursor(false);
+    if (_swap_text(text, cursor) == false) {
+        return CursorPos();
+    }
+    cursor.clear_selection();
+    return cursor;
+}
+bool TextBuffer::_swap_text(const std::string& text, CursorPos& cursor) {
+    auto len1   = length();
+    auto len2   = static_cast<int>(text.length());
+    auto start  = 0;
+    auto end    = 0;
+    while (start < len1 && start < len2 && byte_at(start) == text[start]) {
+        start++;
+    }
+    while (end < len1 - start && end < len2 - start && byte_at(len1 - end - 1) == text[len2 - end - 1]) {
+        end++;
+    }
+    if (start == len1 && start == len2) {
+        return false;
+    }
+    auto lock = _undo != nullptr && _undo->is_group_locked() == false;
+    if (lock == true) {
+        _undo->group_lock();
+    }
+    remove(start, len1 - end);
+    insert(start, text.c_str() + start, len2 - start - end);
+    if (lock == true) {
+        _undo->group_unlock_and_add();
+    }
+    cursor.pos1  = (cursor.pos1 >= len1 - end) ? cursor.pos1 + len2 - len1 : std::min(cursor.pos1, start);
+    cursor.pos2  = (cursor.pos2 >= len1 - end) ? cursor.pos2 + len2 - len1 : std::min(cursor.pos2, start);
+    return true;
+}
 Token::Type TextBuffer::_token(const std::string& string) const {
     auto type = Token::NIL;
     for (auto c : string) {
@@ -19710,17 +22271,27 @@ CursorPos TextBuffer::undo(FUndoRange fundocount, CursorPos cursor) {
     if (_undo == nullptr) {
         return cursor;
     }
-    auto node  = _undo->undo();
-    auto c     = 0;
+    auto node = undo::Event();
+    auto last = undo::Event();
+    auto c    = 0;
     _count_changes = 0;
-    if (node.is_null() == true) {
-        return cursor;
+    if (fundocount == FUndoRange::ALL || (fundocount == FUndoRange::SAVEPOINT && _checksum != "")) {
+        c = _undo_jump((fundocount == FUndoRange::ALL) ? -1 : _undo->save_point(), true, cursor);
     }
-    else if (fundocount == FUndoRange::SAVEPOINT && _checksum == "") {
-        return cursor;
+    if (c > 0) {
+        last = _undo->peek_redo().event();
+        node = (fundocount == FUndoRange::SAVEPOINT && undo_check_save_point() == true) ? undo::Event() : _undo->undo();
+    }
+    else {
+        node = _undo->undo();
+        if (node.is_null() == true) {
+            return cursor;
+        }
+        else if (fundocount == FUndoRange::SAVEPOINT && _checksum == "") {
+            return cursor;
+        }
     }
     auto ctrl = BufferController(this, TextBuffer::TIMEOUT_UNDO, false);
-    auto last = undo::Event();
     _pause_undo = true;
     while (node.is_null() == false) {
         last     = node;
@@ -19739,7 +22310,7 @@ CursorPos TextBuffer::undo(FUndoRange fundocount, CursorPos cursor) {
         }
         else if (node.is_delete() == true) {
             c++;
-            insert(node.pos(), node.c_str1());
+            insert(node.pos(), node.c_str1(), len1);
             if (pos < cursor.pos1) {
                 cursor.pos1 += len1;
             }
@@ -19750,7 +22321,7 @@ CursorPos TextBuffer::undo(FUndoRange fundocount, CursorPos cursor) {
         else if (node.is_replace() == true) {
             c++;
             remove(node.pos(), node.pos() + len2);
-            insert(node.pos(), node.c_str1());
+            insert(node.pos(), node.c_str1(), len1);
             if (pos < cursor.pos1) {
                 cursor.pos1 -= len2;
                 cursor.pos1 += len1;
@@ -19760,6 +22331,10 @@ CursorPos TextBuffer::undo(FUndoRange fundocount, CursorPos cursor) {
                 cursor.pos2 += len1;
             }
         }
+        else if (node.is_diff() == true) {
+            c++;
+            _undo_diff(node, true, cursor);
+        }
         auto p = _undo->peek_undo();
         if (p.is_null() == false && (p.group() == node.group() || fundocount == FUndoRange::ALL || (fundocount == FUndoRange::SAVEPOINT && undo_check_save_point() == false))) {
             node = _undo->undo();
@@ -19791,6 +22366,9 @@ void TextBuffer::undo_cursor_move_to_statusbar_row(CursorPos& cursor, const undo
     if (node.is_custom1() == true) {
         node.str1_toint(pos);
     }
+    else if (node.is_diff() == true) {
+        pos[0] = node.pos();
+    }
     else if (undo == true) {
         if (node.is_backspace() == true) {
             pos[0] = node.pos() + node.len1();
@@ -19860,6 +22438,83 @@ void TextBuffer::undo_cursor_move_to_statusbar_row(CursorPos& cursor, const undo
         cursor.drag  = 0;
     }
 }
+void TextBuffer::_undo_diff(const undo::Event& node, bool undo, CursorPos& cursor) {
+    auto pos  = node.pos();
+    auto size = static_cast<int>(undo::Undo::DiffSize(node, undo));
+    auto out  = std::string();
+    if (size < 0 || pos + size > length()) {
+        return;
+    }
+    auto text = text_range(pos, pos + size);
+    auto res  = undo::Undo::DiffApply(node, undo, text, size, out);
+    free(text);
+    if (res == false) {
+        return;
+    }
+    remove(pos, pos + size);
+    insert(pos, out.c_str(), static_cast<int>(out.length()));
+    auto end  = pos + static_cast<int>(out.length());
+    auto move = end - pos - size;
+    cursor.pos1 = (cursor.pos1 >= pos + size) ? cursor.pos1 + move : std::min(cursor.pos1, end);
+    cursor.pos2 = (cursor.pos2 >= pos + size) ? cursor.pos2 + move : std::min(cursor.pos2, end);
+}
+void TextBuffer::_undo_diff_begin() {
+    if (_undo == nullptr) {
+        return;
+    }
+    _diff.clear();
+    _diff_end   = -1;
+    _diff_start = -1;
+    _pause_undo = true;
+    _track_diff = true;
+}
+void TextBuffer::_undo_diff_end() {
+    if (_undo == nullptr || _track_diff == false) {
+        return;
+    }
+    _pause_undo = false;
+    _track_diff = false;
+    if (_diff_start >= 0) {
+        auto text = text_range(_diff_start, _diff_end);
+        _undo->add_diff(_diff_start, _diff.c_str(), _diff.length(), text, _diff_end - _diff_start);
+        free(text);
+    }
+    std::string().swap(_diff);
+}
+void TextBuffer::_undo_diff_track(int pos, int inserted_size, int deleted_size, const char* deleted_text) {
+    auto end = pos + deleted_size;
+    if (_diff_start < 0) {
+        _diff.assign(deleted_text, deleted_size);
+        _diff_start = pos;
+        _diff_end   = pos + inserted_size;
+        return;
+    }
+    else if (pos >= _diff_end) {
+        auto gap = text_range(_diff_end, pos);
+        _diff.append(gap, pos - _diff_end);
+        _diff.append(deleted_text, deleted_size);
+        _diff_end = pos + inserted_size;
+        free(gap);
+        return;
+    }
+    else if (end <= _diff_start) {
+        auto gap = text_range(pos + inserted_size, _diff_start + inserted_size - deleted_size);
+        _diff.insert(0, gap, _diff_start - end);
+        _diff.insert(0, deleted_text, deleted_size);
+        _diff_start = pos;
+        _diff_end  += inserted_size - deleted_size;
+        free(gap);
+        return;
+    }
+    if (end > _diff_end) {
+        _diff.append(deleted_text + _diff_end - pos, end - _diff_end);
+    }
+    if (pos < _diff_start) {
+        _diff.insert(0, deleted_text, _diff_start - pos);
+    }
+    _diff_end   = std::max(_diff_end, end) + inserted_size - deleted_size;
+    _diff_start = std::min(_diff_start, pos);
+}
 bool TextBuffer::undo_is_at_save_point() const {
     if (_undo == nullptr || _undo->is_at_save_point() == false) {
         return false;
@@ -19875,6 +22530,16 @@ bool TextBuffer::undo_is_before_save_point() {
     }
     return _undo->is_before_save_point();
 }
+int TextBuffer::_undo_jump(ssize_t target, bool undo, CursorPos& cursor) {
+    auto text  = std::string();
+    auto count = _undo->snapshot_jump(target, undo, text);
+    if (count > 0) {
+        _pause_undo = true;
+        _swap_text(text, cursor);
+        _pause_undo = false;
+    }
+    return count;
+}
 void TextBuffer::undo_set_mode_using_config() {
     if (_config.pref_undo == _fundo) {
         return;
@@ -19890,28 +22555,39 @@ void TextBuffer::undo_set_mode_using_config() {
     else if (_fundo == FUndoMode::FLTK) {
         canUndo(1);
     }
-    else if (_fundo == FUndoMode::FLE_V1 && _config.pref_undo_buffer == true) {
-        _undo = new undo::Undo(new undo::BufferStore());
-    }
-    else if (_fundo == FUndoMode::FLE_V1 && _config.pref_undo_buffer == false) {
-        _undo = new undo::Undo(new undo::VectorStore());
-    }
-    else if (_fundo == FUndoMode::FLE_V2 && _config.pref_undo_buffer == true) {
-        _undo = new undo::Undo(new undo::BufferStore(), FUndoModeFle::TIME);
-    }
-    else if (_fundo == FUndoMode::FLE_V2 && _config.pref_undo_buffer == false) {
-        _undo = new undo::Undo(new undo::VectorStore(), FUndoModeFle::TIME);
-    }
-    else if (_fundo == FUndoMode::FLE_V3 && _config.pref_undo_buffer == true) {
-        _undo = new undo::Undo(new undo::BufferStore(), FUndoModeFle::HARD, 13);
-    }
-    else if (_fundo == FUndoMode::FLE_V3 && _config.pref_undo_buffer == false) {
-        _undo = new undo::Undo(new undo::VectorStore(), FUndoModeFle::HARD, 13);
-    }
     else {
-        assert(false);
+        auto store = (undo::Store*) nullptr;
+        if (_config.pref_undo_buffer == false) {
+            store = new undo::VectorStore();
+        }
+        else if (_config.pref_undo_compress == true) {
+            store = new undo::BlockStore();
+        }
+        else {
+            store = new undo::BufferStore();
+        }
+        if (_fundo == FUndoMode::FLE_V1) {
+            _undo = new undo::Undo(store);
+        }
+        else if (_fundo == FUndoMode::FLE_V2) {
+            _undo = new undo::Undo(store, FUndoModeFle::TIME);
+        }
+        else if (_fundo == FUndoMode::FLE_V3) {
+            _undo = new undo::Undo(store, FUndoModeFle::HARD, 13);
+        }
+        else {
+            delete store;
+            assert(false);
+        }
     }
 }
+void TextBuffer::_undo_snapshot(char* text) {
+    if (_undo == nullptr || static_cast<size_t>(length()) > limits::UNDO_MEMORY_VAL || _undo->snapshot_exists() == true) {
+        free(text);
+        return;
+    }
+    _undo->snapshot_add((text != nullptr) ? text : this->text(), length());
+}
 }
 #include <assert.h>
 namespace fle {
@@ -19931,9 +22607,9 @@ void Event::debug(ssize_t buffer_pos, int count) const {
     char flags[50];
     char Str1[50];
     char Str2[50];
-    sprintf(flags, "|%c%c%c%c%c%c%c| %04x", is_insert() ? 'I' : '_', is_delete() ? 'D' : '_',
+    sprintf(flags, "|%c%c%c%c%c%c%c%c| %04x", is_insert() ? 'I' : '_', is_delete() ? 'D' : '_',
         is_replace() ? 'R' : '_', is_backspace() ? 'B' : '_', is_selected() ? 'S' : '_',
-        is_custom1() ? 'C' : '_', is_custom2() ? 'c' : '_', _group);
+        is_custom1() ? 'C' : '_', is_custom2() ? 'c' : '_', is_diff() ? 'X' : '_', _group);
     strncpy(Str1, _str1.c_str(), 25);
     strncpy(Str2, _str2.c_str(), 25);
     Str1[25] = 0;
@@ -19953,18 +22629,643 @@ void Event::debug(ssize_t buffer_pos, int count) const {
         printf("%8s %6s %15s %9s %9s %s\n", "BUFPOS", "COUNT", "FLAGS      GRP ", "POS", "LEN1", "STR1");
         printf("----------------------------------------------------------------------\n");
     }
-    if (len2() > 0) {
-        int l = (int) (25 - strlen(Str1));
-        printf("%8d %6d %15s %9d %9d |%s| %*s %9d |%s|\n", (int) buffer_pos, count, _flag == 0 ? "|________| XXXX" : flags, _pos, len1(), Str1, l, "", len2(), Str2);
+    if (len2() > 0) {
+        int l = (int) (25 - strlen(Str1));
+        printf("%8d %6d %15s %9d %9d |%s| %*s %9d |%s|\n", (int) buffer_pos, count, _flag == 0 ? "|________| XXXX" : flags, _pos, len1(), Str1, l, "", len2(), Str2);
+    }
+    else {
+        printf("%8d %6d %15s %9d %9d |%s|\n", (int) buffer_pos, count, _flag == 0 ? "|________| XXXX" : flags, _pos, len1(), Str1);
+    }
+    fflush(stdout);
+#else
+    (void) buffer_pos;
+    (void) count;
+#endif
+}
+void Event::write(char* out) const {
+    auto len1 = static_cast<uint32_t>(_str1.length());
+    auto len2 = static_cast<uint32_t>(_str2.length());
+    *out = static_cast<char>(_flag);
+    out++;
+    memcpy(out, &_group, sizeof(_group));
+    out += sizeof(_group);
+    memcpy(out, &_pos, sizeof(_pos));
+    out += sizeof(_pos);
+    memcpy(out, &len1, sizeof(len1));
+    out += sizeof(len1);
+    memcpy(out, _str1.data(), len1);
+    out += len1;
+    memcpy(out, &len2, sizeof(len2));
+    out += sizeof(len2);
+    memcpy(out, _str2.data(), len2);
+}
+EventView::EventView(const char* in) {
+    _flag = static_cast<uint8_t>(*in);
+    in++;
+    memcpy(&_group, in, sizeof(_group));
+    in += sizeof(_group);
+    memcpy(&_pos, in, sizeof(_pos));
+    in += sizeof(_pos);
+    memcpy(&_len1, in, sizeof(_len1));
+    in += sizeof(_len1);
+    _str1 = in;
+    in += _len1;
+    memcpy(&_len2, in, sizeof(_len2));
+    in += sizeof(_len2);
+    _str2 = in;
+}
+size_t                   BlockStore::MEMORY = 0;
+std::vector<BlockStore*> BlockStore::STORES;
+BlockStore::~BlockStore() {
+    clear();
+    auto it = std::find(BlockStore::STORES.begin(), BlockStore::STORES.end(), this);
+    if (it != BlockStore::STORES.end()) {
+        BlockStore::STORES.erase(it);
+    }
+}
+bool BlockStore::append_last(uint8_t flag, int32_t pos, bool second, bool front, const char* in, size_t len) {
+    auto cursor = _bend;
+    if (go_left(cursor) == false || cursor < _hot_start) {
+        return false;
+    }
+    auto base  = static_cast<size_t>(cursor - _hot_start);
+    auto view  = EventView(_hot.data() + base);
+    auto size  = static_cast<uint32_t>(view.size() + sizeof(uint32_t) + len);
+    auto count = static_cast<uint32_t>(((second == true) ? view.len2() : view.len1()) + len);
+    auto field = base + Event::NumberSize() + ((second == true) ? sizeof(uint32_t) + view.len1() : 0);
+    auto at    = field + sizeof(uint32_t) + ((front == true) ? 0 : count - len);
+    _hot.insert(at, in, len);
+    _hot[base] = static_cast<char>(flag);
+    memcpy(&_hot[base + sizeof(uint8_t) + sizeof(uint16_t)], &pos, sizeof(pos));
+    memcpy(&_hot[field], &count, sizeof(count));
+    memcpy(&_hot[_hot.length() - sizeof(size)], &size, sizeof(size));
+    _bend += len;
+    _bcur  = _bend;
+    _move  = MOVE::END;
+    return true;
+}
+size_t BlockStore::_block(ssize_t pos) const {
+    auto first = (size_t) 0;
+    auto last  = _blocks.size();
+    while (first + 1 < last) {
+        auto mid = first + (last - first) / 2;
+        if (_blocks[mid].start <= pos) {
+            first = mid;
+        }
+        else {
+            last = mid;
+        }
+    }
+    return first;
+}
+const std::vector<BlockStore::Block>& BlockStore::blocks() {
+    for (auto& block : _blocks) {
+        _pack(block, true);
+    }
+    return _blocks;
+}
+std::string BlockStore::block_data(size_t index) const {
+    auto res = std::string();
+    if (index >= _blocks.size()) {
+        return res;
+    }
+    else if (_blocks[index].offset < 0) {
+        res = _blocks[index].data;
+    }
+    else if (_read(_blocks[index], res) == false) {
+        res = "";
+    }
+    return res;
+}
+ssize_t BlockStore::capacity() const {
+    ssize_t ret = _hot.capacity() + _cache.capacity() + _blocks.capacity() * sizeof(Block);
+    for (const auto& block : _blocks) {
+        ret += block.data.capacity();
+    }
+    return ret;
+}
+void BlockStore::clear() {
+    BlockStore::MEMORY -= _memory;
+    _memory = 0;
+    _close();
+    _blocks.clear();
+    _blocks.shrink_to_fit();
+    std::string().swap(_hot);
+    std::string().swap(_cache);
+    _cache_block = -1;
+    _hot_start   = 0;
+    _bcur        = -1;
+    _bend        = -1;
+    _move        = MOVE::END;
+}
+void BlockStore::_close() {
+    if (_file != nullptr) {
+        fclose(_file);
+        gnu::file::remove(_filename);
+    }
+    _file     = nullptr;
+    _file_end = 0;
+    _filename = "";
+}
+std::string BlockStore::Compress(const char* in, size_t in_len) {
+    auto table  = std::vector<int32_t>(4'096, -1);
+    auto res    = std::string();
+    auto anchor = (size_t) 0;
+    auto pos    = (size_t) 0;
+    auto emit   = [&](size_t lit_len, size_t offset, size_t match_len) {
+        auto token = static_cast<uint8_t>(std::min(lit_len, (size_t) 15) << 4);
+        if (match_len > 0) {
+            token |= static_cast<uint8_t>(std::min(match_len - 4, (size_t) 15));
+        }
+        res += static_cast<char>(token);
+        if (lit_len >= 15) {
+            auto rest = lit_len - 15;
+            while (rest >= 255) {
+                res += static_cast<char>(255);
+                rest -= 255;
+            }
+            res += static_cast<char>(rest);
+        }
+        res.append(in + anchor, lit_len);
+        if (match_len > 0) {
+            res += static_cast<char>(offset & 0xff);
+            res += static_cast<char>(offset >> 8);
+            if (match_len - 4 >= 15) {
+                auto rest = match_len - 4 - 15;
+                while (rest >= 255) {
+                    res += static_cast<char>(255);
+                    rest -= 255;
+                }
+                res += static_cast<char>(rest);
+            }
+        }
+    };
+    res.reserve(in_len / 2 + 16);
+    while (pos + 4 <= in_len) {
+        auto seq  = (uint32_t) 0;
+        memcpy(&seq, in + pos, sizeof(seq));
+        auto hash = static_cast<size_t>((seq * 2'654'435'761u) >> 20);
+        auto ref  = table[hash];
+        table[hash] = static_cast<int32_t>(pos);
+        if (ref >= 0 && pos - ref <= 65'535 && memcmp(in + ref, in + pos, 4) == 0) {
+            auto len = (size_t) 4;
+            while (pos + len < in_len && in[ref + len] == in[pos + len]) {
+                len++;
+            }
+            emit(pos - anchor, pos - ref, len);
+            pos   += len;
+            anchor = pos;
+        }
+        else {
+            pos++;
+        }
+    }
+    emit(in_len - anchor, 0, 0);
+    return res;
+}
+ssize_t BlockStore::debug(bool all) const {
+#ifdef DEBUG
+    ssize_t cursor1 = 0;
+    ssize_t count   = 0;
+    printf("\nEvent:\n");
+    while (cursor1 < _bend) {
+        count++;
+        if (all == true) {
+            get_node(cursor1).debug(cursor1, count);
+        }
+        go_right(cursor1);
+    }
+    printf("\nBlockStore:\n");
+    printf("    count_all          = %8d\n", (int) count);
+    printf("    blocks             = %8d\n", (int) _blocks.size());
+    printf("    capacity           = %8lld\n", (long long int) capacity());
+    printf("    raw_capacity       = %8lld\n", (long long int) raw_capacity());
+    printf("    memory             = %8lld\n", (long long int) _memory);
+    printf("    memory_all         = %8lld\n", (long long int) BlockStore::MEMORY);
+    printf("    file_end           = %8lld\n", (long long int) _file_end);
+    printf("    hot_start          = %8lld\n", (long long int) _hot_start);
+    printf("    bcur               = %8lld\n", (long long int) _bcur);
+    printf("    bend               = %8lld\n", (long long int) _bend);
+    printf("    move               = %8d\n", (int) _move);
+    fflush(stdout);
+    return count;
+#else
+    (void) all;
+    return 0;
+#endif
+}
+bool BlockStore::Decompress(const char* in, size_t in_len, std::string& out, size_t out_len) {
+    auto pos = (size_t) 0;
+    out.clear();
+    out.reserve(out_len);
+    while (pos < in_len) {
+        auto token = static_cast<uint8_t>(in[pos++]);
+        auto len   = static_cast<size_t>(token >> 4);
+        if (len == 15) {
+            auto c = (uint8_t) 255;
+            while (c == 255 && pos < in_len) {
+                c    = static_cast<uint8_t>(in[pos++]);
+                len += c;
+            }
+        }
+        if (pos + len > in_len || out.length() + len > out_len) {
+            return false;
+        }
+        out.append(in + pos, len);
+        pos += len;
+        if (pos >= in_len) {
+            break;
+        }
+        else if (pos + 2 > in_len) {
+            return false;
+        }
+        auto offset = static_cast<size_t>(static_cast<uint8_t>(in[pos])) | (static_cast<size_t>(static_cast<uint8_t>(in[pos + 1])) << 8);
+        pos += 2;
+        len  = static_cast<size_t>(token & 15);
+        if (len == 15) {
+            auto c = (uint8_t) 255;
+            while (c == 255 && pos < in_len) {
+                c    = static_cast<uint8_t>(in[pos++]);
+                len += c;
+            }
+        }
+        len += 4;
+        if (offset == 0 || offset > out.length() || out.length() + len > out_len) {
+            return false;
+        }
+        auto from = out.length() - offset;
+        for (size_t f = 0; f < len; f++) {
+            out += out[from + f];
+        }
+    }
+    return out.length() == out_len;
+}
+const Event BlockStore::get_node(ssize_t cursor) const {
+    if (cursor < 0 || cursor >= _bend) {
+        return Event();
+    }
+    return EventView(_ptr(cursor)).event();
+}
+bool BlockStore::go_left() {
+    if (_move == MOVE::RIGHT) {
+        _move = MOVE::LEFT;
+        return true;
+    }
+    else if (go_left(_bcur) == true) {
+        _move = MOVE::LEFT;
+        return true;
+    }
+    else {
+        _move = MOVE::END;
+        return false;
+    }
+}
+bool BlockStore::go_left(ssize_t& cursor) const {
+    if (cursor > 8) {
+        auto size = (uint32_t) 0;
+        memcpy(&size, _ptr(cursor - sizeof(size)), sizeof(size));
+        cursor -= size;
+        if (cursor >= 0) {
+            return true;
+        }
+    }
+    cursor = -1;
+    return false;
+}
+bool BlockStore::go_right() {
+    if (_move == MOVE::LEFT) {
+        _move = MOVE::RIGHT;
+        return true;
+    }
+    else if (go_right(_bcur) == true && _bcur < _bend) {
+        _move = MOVE::RIGHT;
+        return true;
+    }
+    else {
+        _move = MOVE::END;
+        _bcur = _bend;
+        return false;
+    }
+}
+bool BlockStore::go_right(ssize_t& cursor) const {
+    if (cursor < 0 && _bend > 0) {
+        cursor = 0;
+        return true;
+    }
+    else if (cursor >= 0 && cursor < _bend) {
+        cursor += EventView(_ptr(cursor)).size() + sizeof(uint32_t);
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+void BlockStore::go_right_before_cut() {
+    if (_move == MOVE::RIGHT) {
+        go_right(_bcur);
+        _move = MOVE::END;
+    }
+}
+void BlockStore::invalidate_group_counter_at_cursor() {
+    if (_bcur < 0 || _bcur >= _bend) {
+        return;
+    }
+    auto group = (uint16_t) 0;
+    auto b     = const_cast<char*>(_ptr(_bcur)) + 1;
+    memcpy(&group, b, sizeof(group));
+    group += 32768;
+    memcpy(b, &group, sizeof(group));
+    if (_bcur < _hot_start) {
+        auto& block = _blocks[_block(_bcur)];
+        if (block.packed == true || block.offset >= 0) {
+            if (block.offset < 0) {
+                _memory            -= block.size;
+                BlockStore::MEMORY -= block.size;
+            }
+            block.data   = (block.packed == true) ? Compress(_cache.data(), _cache.length()) : _cache;
+            block.offset = -1;
+            block.size   = block.data.length();
+            block.data.shrink_to_fit();
+            _memory            += block.size;
+            BlockStore::MEMORY += block.size;
+        }
+        block.hash = gnu::file::fletcher64(block.data.data(), block.data.length());
+    }
+}
+const EventView BlockStore::peek_left() const {
+    auto cursor1 = _bcur;
+    if (go_left(cursor1) == true && cursor1 < _bend) {
+        return EventView(_ptr(cursor1));
+    }
+    else {
+        return EventView();
+    }
+}
+const EventView BlockStore::peek_right() const {
+    auto cursor1 = _bcur;
+    if (go_right(cursor1) == true && cursor1 < _bend) {
+        return EventView(_ptr(cursor1));
+    }
+    else {
+        return EventView();
+    }
+}
+void BlockStore::pop() {
+    if (go_left(_bcur) == true) {
+        _bend = _bcur;
+        _truncate(_bend);
+    }
+    _move = MOVE::END;
+}
+bool BlockStore::_pack(Block& block, bool wait) {
+    if (block.pending.valid() == false) {
+        return true;
+    }
+    else if (wait == false && block.pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return false;
+    }
+    auto data = block.pending.get();
+    if (data.length() < block.data.length()) {
+        _memory            -= block.size;
+        BlockStore::MEMORY -= block.size;
+        block.data.swap(data);
+        block.data.shrink_to_fit();
+        block.packed        = true;
+        block.size          = block.data.length();
+        _memory            += block.size;
+        BlockStore::MEMORY += block.size;
+    }
+    block.hash = gnu::file::fletcher64(block.data.data(), block.data.length());
+    return true;
+}
+const char* BlockStore::_ptr(ssize_t pos) const {
+    if (pos >= _hot_start) {
+        return _hot.data() + (pos - _hot_start);
+    }
+    auto  index = _block(pos);
+    auto& block = _blocks[index];
+    if (block.packed == false && block.offset < 0) {
+        return block.data.data() + (pos - block.start);
+    }
+    else if (_cache_block != static_cast<ssize_t>(index)) {
+        auto ok = true;
+        if (block.offset < 0) {
+            ok = Decompress(block.data.data(), block.data.length(), _cache, block.end - block.start);
+        }
+        else if (block.packed == true) {
+            auto data = std::string();
+            ok = _read(block, data) == true && Decompress(data.data(), data.length(), _cache, block.end - block.start) == true;
+        }
+        else {
+            ok = _read(block, _cache);
+        }
+        assert(ok == true);
+        if (ok == false) {
+            _cache.assign(block.end - block.start, 0);
+        }
+        _cache.shrink_to_fit();
+        _cache_block = index;
+    }
+    return _cache.data() + (pos - block.start);
+}
+ssize_t BlockStore::raw_capacity() const {
+    ssize_t ret = _hot.capacity() + _cache.capacity() + _blocks.capacity() * sizeof(Block);
+    for (const auto& block : _blocks) {
+        ret += block.end - block.start;
+    }
+    return ret;
+}
+bool BlockStore::_read(const Block& block, std::string& out) const {
+    out.resize(block.size);
+    return _file != nullptr && _seek(block.offset) == true && fread(&out[0], 1, block.size, _file) == block.size;
+}
+bool BlockStore::restore(std::vector<Block>& blocks, const std::string& hot, ssize_t cursor) {
+    auto start = (ssize_t) 0;
+    for (const auto& block : blocks) {
+        if (block.start != start || block.end <= block.start || block.size != block.data.length() || block.hash != gnu::file::fletcher64(block.data.data(), block.data.length())) {
+            return false;
+        }
+        start = block.end;
+    }
+    if (start + static_cast<ssize_t>(hot.length()) == 0 || cursor >= start + static_cast<ssize_t>(hot.length())) {
+        return false;
+    }
+    clear();
+    _blocks.swap(blocks);
+    for (auto& block : _blocks) {
+        block.offset        = -1;
+        _memory            += block.size;
+        BlockStore::MEMORY += block.size;
+    }
+    _hot       = hot;
+    _hot_start = start;
+    _bend      = _hot_start + _hot.length();
+    seek(cursor);
+    if (_memory > limits::UNDO_MEMORY_VAL) {
+        _spill(limits::UNDO_MEMORY_VAL);
+    }
+    return true;
+}
+void BlockStore::_seal() {
+    if (static_cast<ssize_t>(_hot.length()) < BLOCK_SIZE * 2) {
+        return;
+    }
+    auto end  = _bend;
+    auto last = _hot_start;
+    go_left(end);
+    while (last < end && last - _hot_start < BLOCK_SIZE) {
+        go_right(last);
+    }
+    if (last <= _hot_start) {
+        return;
+    }
+    for (auto& block : _blocks) {
+        _pack(block, false);
+    }
+    auto block    = Block();
+    block.start   = _hot_start;
+    block.end     = last;
+    block.data    = _hot.substr(0, last - _hot_start);
+    block.hash    = 0;
+    block.offset  = -1;
+    block.packed  = false;
+    block.size    = block.data.length();
+    block.pending = std::async(std::launch::async, [](std::string raw) {
+        return BlockStore::Compress(raw.data(), raw.length());
+    }, block.data);
+    _memory            += block.size;
+    BlockStore::MEMORY += block.size;
+    _blocks.push_back(std::move(block));
+    _hot       = _hot.substr(last - _hot_start);
+    _hot_start = last;
+    if (_memory > limits::UNDO_MEMORY_VAL) {
+        _spill(limits::UNDO_MEMORY_VAL);
+    }
+    Undo::SnapshotEvict();
+    for (auto store : BlockStore::STORES) {
+        if (BlockStore::MEMORY <= limits::UNDO_MEMORY_ALL_VAL) {
+            break;
+        }
+        else if (store != this) {
+            store->_spill(0);
+        }
+    }
+    if (BlockStore::MEMORY > limits::UNDO_MEMORY_ALL_VAL) {
+        _spill(0);
+    }
+}
+bool BlockStore::_seek(int64_t pos) const {
+#ifdef _WIN32
+    return _fseeki64(_file, pos, SEEK_SET) == 0;
+#else
+    return fseeko(_file, static_cast<off_t>(pos), SEEK_SET) == 0;
+#endif
+}
+void BlockStore::seek(ssize_t cursor) {
+    if (_bend <= 0) {
+        return;
+    }
+    else if (cursor < 0) {
+        _bcur = 0;
+        _move = MOVE::LEFT;
+    }
+    else {
+        _bcur = cursor;
+        go_right(_bcur);
+        _move = (_bcur >= _bend) ? MOVE::END : MOVE::LEFT;
+    }
+}
+void BlockStore::set_node(const Event& node) {
+    if (_bcur < 0) {
+        _bcur = 0;
+    }
+    _truncate(_bcur);
+    auto size = static_cast<uint32_t>(node.size() + sizeof(uint32_t));
+    auto hot  = _hot.length();
+    _hot.resize(hot + node.size());
+    node.write(&_hot[hot]);
+    _hot.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    _bcur += size;
+    _bend  = _bcur;
+    _move  = MOVE::END;
+    _seal();
+}
+void BlockStore::_spill(size_t budget) {
+    for (auto& block : _blocks) {
+        if (_memory <= budget) {
+            break;
+        }
+        else if (block.offset >= 0) {
+            continue;
+        }
+        _pack(block, true);
+        if (_memory <= budget) {
+            break;
+        }
+        else if (_file == nullptr) {
+            _filename = gnu::file::tmp_file("fledit_undo_").filename();
+            _file     = gnu::file::open(_filename, "w+b");
+            _file_end = 0;
+            if (_file == nullptr) {
+                return;
+            }
+        }
+        if (_seek(_file_end) == false || fwrite(block.data.data(), 1, block.size, _file) != block.size) {
+            return;
+        }
+        block.offset        = _file_end;
+        _file_end          += block.size;
+        _memory            -= block.size;
+        BlockStore::MEMORY -= block.size;
+        std::string().swap(block.data);
+    }
+}
+void BlockStore::_truncate(ssize_t pos) {
+    if (pos >= _hot_start) {
+        _hot.resize(pos - _hot_start);
+        return;
+    }
+    auto index = _block(pos);
+    auto start = _blocks[index].start;
+    _hot       = std::string(_ptr(pos) - (pos - start), pos - start);
+    _hot_start = start;
+    for (auto f = index; f < _blocks.size(); f++) {
+        if (_blocks[f].offset < 0) {
+            _memory            -= _blocks[f].size;
+            BlockStore::MEMORY -= _blocks[f].size;
+        }
+    }
+    _blocks.resize(index);
+    _cache_block = -1;
+    _file_end    = 0;
+    std::string().swap(_cache);
+    for (const auto& block : _blocks) {
+        if (block.offset >= 0) {
+            _file_end = std::max(_file_end, block.offset + static_cast<int64_t>(block.size));
+        }
     }
-    else {
-        printf("%8d %6d %15s %9d %9d |%s|\n", (int) buffer_pos, count, _flag == 0 ? "|________| XXXX" : flags, _pos, len1(), Str1);
+}
+bool BufferStore::append_last(uint8_t flag, int32_t pos, bool second, bool front, const char* in, size_t len) {
+    auto cursor = _bend;
+    if (go_left(cursor) == false) {
+        return false;
     }
-    fflush(stdout);
-#else
-    (void) buffer_pos;
-    (void) count;
-#endif
+    auto view  = EventView(_buf + cursor);
+    auto size  = static_cast<uint32_t>(view.size() + sizeof(uint32_t) + len);
+    auto count = static_cast<uint32_t>(((second == true) ? view.len2() : view.len1()) + len);
+    auto field = cursor + Event::NumberSize() + ((second == true) ? sizeof(uint32_t) + view.len1() : 0);
+    auto at    = field + sizeof(uint32_t) + ((front == true) ? 0 : count - len);
+    _buffer_increase(_bend + len);
+    memmove(_buf + at + len, _buf + at, _bend - at);
+    memcpy(_buf + at, in, len);
+    _buf[cursor] = static_cast<char>(flag);
+    memcpy(_buf + cursor + sizeof(uint8_t) + sizeof(uint16_t), &pos, sizeof(pos));
+    memcpy(_buf + field, &count, sizeof(count));
+    _bend += len;
+    _bcur  = _bend;
+    _move  = MOVE::END;
+    memcpy(_buf + _bend - sizeof(size), &size, sizeof(size));
+    return true;
 }
 bool BufferStore::_buffer_decrease() {
     auto new_bcap = _bcap;
@@ -20048,23 +23349,7 @@ const Event BufferStore::get_node(ssize_t cursor) const {
     if (cursor < 0 || cursor >= _bend) {
         return Event();
     }
-    auto b     = static_cast<const char*>(_buf + cursor);
-    auto flag  = (uint8_t) 0;
-    auto group = (uint16_t) 0;
-    auto pos   = (int32_t) 0;
-    auto str1  = (const char*) nullptr;
-    auto str2  = (const char*) nullptr;
-    flag = *b;
-    b++;
-    memcpy(&group, b, sizeof(group));
-    b += sizeof(group);
-    memcpy(&pos, b, sizeof(pos));
-    b += sizeof(pos);
-    str1 = b;
-    b    = b + strlen(str1) + 1;
-    str2 = b;
-    b    = b + strlen(str2) + 1;
-    return Event(flag, group, pos, str1, str2);
+    return EventView(_buf + cursor).event();
 }
 bool BufferStore::go_left() {
     if (_move == MOVE::RIGHT) {
@@ -20115,14 +23400,7 @@ bool BufferStore::go_right(ssize_t& cursor) const {
         return true;
     }
     else if (cursor >= 0 && cursor < _bend) {
-        auto b = _buf + cursor;
-        b += Event::NumberSize();
-        b += strlen(b);
-        b++;
-        b += strlen(b);
-        b++;
-        b += sizeof(uint32_t);
-        cursor = static_cast<ssize_t>(static_cast<std::ptrdiff_t>(b - _buf));
+        cursor += EventView(_buf + cursor).size() + sizeof(uint32_t);
         return true;
     }
     else {
@@ -20146,22 +23424,22 @@ void BufferStore::invalidate_group_counter_at_cursor() {
     group += 32768;
     memcpy(b, &group, sizeof(group));
 }
-const Event BufferStore::peek_left() const {
+const EventView BufferStore::peek_left() const {
     auto cursor1 = _bcur;
-    if (go_left(cursor1) == true) {
-        return get_node(cursor1);
+    if (go_left(cursor1) == true && cursor1 < _bend) {
+        return EventView(_buf + cursor1);
     }
     else {
-        return Event();
+        return EventView();
     }
 }
-const Event BufferStore::peek_right() const {
+const EventView BufferStore::peek_right() const {
     auto cursor1 = _bcur;
-    if (go_right(cursor1) == true) {
-        return get_node(cursor1);
+    if (go_right(cursor1) == true && cursor1 < _bend) {
+        return EventView(_buf + cursor1);
     }
     else {
-        return Event();
+        return EventView();
     }
 }
 void BufferStore::pop() {
@@ -20170,6 +23448,20 @@ void BufferStore::pop() {
     }
     _move = MOVE::END;
 }
+void BufferStore::seek(ssize_t cursor) {
+    if (_bend <= 0) {
+        return;
+    }
+    else if (cursor < 0) {
+        _bcur = 0;
+        _move = MOVE::LEFT;
+    }
+    else {
+        _bcur = cursor;
+        go_right(_bcur);
+        _move = (_bcur >= _bend) ? MOVE::END : MOVE::LEFT;
+    }
+}
 void BufferStore::set_node(const Event& node) {
     if (_bcur < 0) {
         _bcur = 0;
@@ -20177,20 +23469,8 @@ void BufferStore::set_node(const Event& node) {
     auto size = static_cast<uint32_t>(node.size() + sizeof(uint32_t));
     auto inc  = _buffer_increase(_bcur + size);
     auto b    = static_cast<char*>(_buf + _bcur);
-    *b = node.flag();
-    b++;
-    auto group = node.group();
-    memcpy(b, &group, sizeof(group));
-    b += sizeof(group);
-    auto pos = node.pos();
-    memcpy(b, &pos, sizeof(pos));
-    b += sizeof(pos);
-    auto l = node.len1() + 1;
-    memcpy(b, node.c_str1(), l);
-    b += l;
-    l = node.len2() + 1;
-    memcpy(b, node.c_str2(), l);
-    b += l;
+    node.write(b);
+    b += node.size();
     auto old_end = _bend;
     memcpy(b, &size, sizeof(size));
     _bcur += size;
@@ -20200,6 +23480,19 @@ void BufferStore::set_node(const Event& node) {
         _buffer_decrease();
     }
 }
+bool VectorStore::append_last(uint8_t flag, int32_t pos, bool second, bool front, const char* in, size_t len) {
+    if (_events.size() == 0) {
+        return false;
+    }
+    auto& last = _events.back();
+    auto& str  = (second == true) ? last._str2 : last._str1;
+    str.insert((front == true) ? 0 : str.length(), in, len);
+    last._flag = flag;
+    last._pos  = pos;
+    _cur       = _events.size();
+    _move      = MOVE::END;
+    return true;
+}
 ssize_t VectorStore::capacity() const {
     ssize_t ret = 0;
     for (const auto& n : _events) {
@@ -20308,22 +23601,22 @@ void VectorStore::invalidate_group_counter_at_cursor() {
     }
     _events[_cur]._group += 32768;
 }
-const Event VectorStore::peek_left() const {
+const EventView VectorStore::peek_left() const {
     auto cursor1 = _cur;
-    if (go_left(cursor1) == true) {
-        return get_node(cursor1);
+    if (go_left(cursor1) == true && cursor1 < static_cast<ssize_t>(_events.size())) {
+        return EventView(_events[cursor1]);
     }
     else {
-        return Event();
+        return EventView();
     }
 }
-const Event VectorStore::peek_right() const {
+const EventView VectorStore::peek_right() const {
     auto cursor1 = _cur;
-    if (go_right(cursor1) == true) {
-        return get_node(cursor1);
+    if (go_right(cursor1) == true && cursor1 < static_cast<ssize_t>(_events.size())) {
+        return EventView(_events[cursor1]);
     }
     else {
-        return Event();
+        return EventView();
     }
 }
 void VectorStore::pop() {
@@ -20332,6 +23625,20 @@ void VectorStore::pop() {
     }
     _move = MOVE::END;
 }
+void VectorStore::seek(ssize_t cursor) {
+    if (_events.size() == 0) {
+        return;
+    }
+    else if (cursor < 0) {
+        _cur  = 0;
+        _move = MOVE::LEFT;
+    }
+    else {
+        _cur  = cursor;
+        go_right(_cur);
+        _move = (_cur >= static_cast<ssize_t>(_events.size())) ? MOVE::END : MOVE::LEFT;
+    }
+}
 void VectorStore::set_node(const Event& node) {
     if (_cur < 0) {
         _cur = 0;
@@ -20350,6 +23657,7 @@ void VectorStore::set_node(const Event& node) {
     _move = MOVE::END;
     _cur  = _events.size();
 }
+std::vector<Undo*> Undo::UNDOS;
 Undo::Undo(Store* store, FUndoModeFle fundoappend, size_t break_at, double break_time) {
     _tokens.set(' ', Token::PUNCTUATOR);
     _tokens.set('\t', Token::PUNCTUATOR);
@@ -20361,8 +23669,17 @@ Undo::Undo(Store* store, FUndoModeFle fundoappend, size_t break_at, double break
     _fundoappend = fundoappend;
     _break_at    = break_at;
     _break_time  = break_time;
+    Undo::UNDOS.push_back(this);
     clear();
 }
+Undo::~Undo() {
+    auto it = std::find(Undo::UNDOS.begin(), Undo::UNDOS.end(), this);
+    if (it != Undo::UNDOS.end()) {
+        Undo::UNDOS.erase(it);
+    }
+    _snapshot_cut(Undo::SAVE_POINT_NONE);
+    delete _store;
+}
 STATUS Undo::add(const FDelKey delkey, const bool selection, const int pos, const char* inserted_text, const int inserted_len, const char* deleted_text, const int deleted_len) {
     auto flag   = (uint8_t) 0;
     auto type   = (uint16_t) Token::NIL;
@@ -20371,7 +23688,7 @@ STATUS Undo::add(const FDelKey delkey, const bool selection, const int pos, cons
     auto time   = gnu::Time::Clock();
     auto diff   = time - _time;
     if (_store->cursor() < _save_point) {
-        _save_point = -1;
+        _save_point = Undo::SAVE_POINT_NONE;
     }
     if (_break > 0 || _append_len >= _break_at) {
         append = false;
@@ -20397,7 +23714,7 @@ STATUS Undo::add(const FDelKey delkey, const bool selection, const int pos, cons
     }
     if (deleted_len > 0 && inserted_len > 0) {
         flag |= static_cast<uint8_t>(EVENT::REPLACE);
-        added = _add(nullptr, flag, pos, deleted_text, inserted_text);
+        added = _add(nullptr, flag, pos, deleted_text, deleted_len, inserted_text, inserted_len);
     }
     else if (deleted_len > 0) {
         auto last = peek_undo();
@@ -20407,39 +23724,39 @@ STATUS Undo::add(const FDelKey delkey, const bool selection, const int pos, cons
         }
         if (last.is_null() == false && append == true) {
             if (delkey == FDelKey::DEL && pos == last.pos()) {
-                added = _add(&last, flag, pos, deleted_text);
+                added = _add(&last, flag, pos, deleted_text, deleted_len);
                 goto EXIT;
             }
             else if (delkey == FDelKey::BACKSPACE && pos + deleted_len == last.pos()) {
-                added = _add(&last, flag, pos, deleted_text);
+                added = _add(&last, flag, pos, deleted_text, deleted_len);
                 goto EXIT;
             }
         }
-        added = _add(nullptr, flag, pos, deleted_text);
+        added = _add(nullptr, flag, pos, deleted_text, deleted_len);
     }
     else if (inserted_len > 0) {
         auto last = peek_undo();
         flag |= static_cast<uint8_t>(EVENT::INSERT);
         if (last.is_null() == false) {
             if (last.is_insert() == true && append == true && pos == last.pos() + last.len1()) {
-                added = _add(&last, flag, pos, inserted_text);
+                added = _add(&last, flag, pos, inserted_text, inserted_len);
                 goto EXIT;
             }
             else if (last.is_replace() == true && append == true && pos == last.pos() + last.len2()) {
-                added = _add(&last, flag, pos, inserted_text);
+                added = _add(&last, flag, pos, inserted_text, inserted_len);
                 goto EXIT;
             }
             else if (last.is_delete() == true && pos == last.pos() && selection == true) {
-                added = _add(&last, flag, pos, inserted_text);
+                added = _add(&last, flag, pos, inserted_text, inserted_len);
                 goto EXIT;
             }
         }
         if (_custom2 != "") {
             flag |= static_cast<uint8_t>(EVENT::CUSTOM2);
-            added = _add(nullptr, flag, pos, inserted_text, _custom2.c_str());
+            added = _add(nullptr, flag, pos, inserted_text, inserted_len, _custom2.c_str(), _custom2.length());
         }
         else {
-            added = _add(nullptr, flag, pos, inserted_text);
+            added = _add(nullptr, flag, pos, inserted_text, inserted_len);
         }
     }
     group_add();
@@ -20460,79 +23777,119 @@ EXIT:
     else {
         _append_len = 0;
     }
+    if (added == STATUS::ADDED) {
+        _snapshot_events++;
+    }
     if (_break > 0) {
         _break--;
     }
     return added;
 }
-STATUS Undo::_add(Event* last, uint8_t flag, int pos, const char* str1, const char* str2) {
-    if (_is_cursor_at_end() == true && last != nullptr) {
-        auto added = _append_to_node(last, flag, pos, str1);
+STATUS Undo::_add(EventView* last, uint8_t flag, int pos, const char* str1, size_t len1, const char* str2, size_t len2) {
+    if (_is_cursor_at_end() == true && last != nullptr && _custom1.is_null() == true) {
+        auto added = _append_to_node(last, flag, pos, str1, len1);
         if (added != STATUS::INIT) {
             return added;
         }
     }
-    auto node = Event(flag, _group, pos, str1, str2);
+    auto node = Event(flag, _group, pos, str1, len1, str2, len2);
     _push_node_to_buf(node);
     return STATUS::ADDED;
 }
-STATUS Undo::_append_to_node(Event* last, uint8_t flag, int pos, const char* str) {
+STATUS Undo::add_diff(int offset, const char* before, size_t before_len, const char* after, size_t after_len) {
+    auto pos  = 0;
+    auto str1 = std::string();
+    auto str2 = std::string();
+    if (Undo::Diff(before, before_len, after, after_len, pos, str1, str2) == false) {
+        return STATUS::INIT;
+    }
+    pos += offset;
+    if (_store->cursor() < _save_point) {
+        _save_point = Undo::SAVE_POINT_NONE;
+    }
+    _push_node_to_buf(Event(static_cast<uint8_t>(EVENT::DIFF), _group, pos, str1.c_str(), str1.length(), str2.c_str(), str2.length()));
+    _append_len = 0;
+    _prev_type  = Token::NIL;
+    _snapshot_events++;
+    group_add();
+    return STATUS::ADDED;
+}
+STATUS Undo::_append_to_node(EventView* last, uint8_t flag, int pos, const char* str, size_t len) {
+    auto res = false;
     if (flag & static_cast<uint8_t>(EVENT::INSERT)) {
         if (last->is_insert() == true) {
-            last->append_str1(str);
-            _store->go_left();
-            _push_node_to_buf(*last);
-            return STATUS::APPENDED;
+            res = _store->append_last(last->flag(), last->pos(), false, false, str, len);
         }
         else if (last->is_replace() == true) {
-            last->append_str2(str);
-            _store->go_left();
-            _push_node_to_buf(*last);
-            return STATUS::APPENDED;
+            res = _store->append_last(last->flag(), last->pos(), true, false, str, len);
         }
         else if (last->is_delete() == true) {
             assert(last->len2() == 0);
-            last->flag(static_cast<uint8_t>(EVENT::REPLACE) | static_cast<uint8_t>(EVENT::SELECTED));
-            last->str2(str);
-            if (last->str1() == last->str2()) {
+            if (static_cast<size_t>(last->len1()) == len && memcmp(last->str1(), str, len) == 0) {
                 _store->pop();
+                _snapshot_cut(_store->cursor() + 1);
                 return STATUS::REMOVED;
             }
-            else {
-                _store->go_left();
-                _push_node_to_buf(*last);
-                return STATUS::APPENDED;
-            }
+            res = _store->append_last(static_cast<uint8_t>(EVENT::REPLACE) | static_cast<uint8_t>(EVENT::SELECTED), last->pos(), true, false, str, len);
         }
     }
     else if (flag & static_cast<uint8_t>(EVENT::ERASED) && last->is_delete() == true) {
         if (flag & static_cast<uint8_t>(EVENT::BACKSPACE)) {
-            last->pos(pos);
-            last->insert_str1(str);
-            _store->go_left();
-            _push_node_to_buf(*last);
-            return STATUS::APPENDED;
+            res = _store->append_last(last->flag(), pos, false, true, str, len);
         }
         else {
-            last->append_str1(str);
-            _store->go_left();
-            _push_node_to_buf(*last);
-            return STATUS::APPENDED;
+            res = _store->append_last(last->flag(), last->pos(), false, false, str, len);
         }
     }
-    return STATUS::INIT;
+    if (res == false) {
+        return STATUS::INIT;
+    }
+    _snapshot_cut(_store->cursor());
+    return STATUS::APPENDED;
+}
+std::string Undo::Benchmark(Store* store, const std::string& name, int count) {
+    auto undo  = Undo(store);
+    auto text  = "the quick brown fox jumps over the lazy dog ";
+    auto size  = strlen(text);
+    auto time1 = gnu::Time::Milli();
+    for (auto f = 0; f < count; f++) {
+        (void) undo.add(FDelKey::NIL, false, f, text + f % size, 1);
+    }
+    time1 = gnu::Time::Milli() - time1;
+    auto events = 0;
+    auto time2  = gnu::Time::Milli();
+    while (undo.peek_undo().is_null() == false) {
+        undo.undo();
+        events++;
+    }
+    time2 = gnu::Time::Milli() - time2;
+    auto time3 = gnu::Time::Milli();
+    while (undo.peek_redo().is_null() == false) {
+        undo.redo();
+    }
+    time3 = gnu::Time::Milli() - time3;
+    return gnu::str::format("%-12s %8d inserts| %7d events| add: %5d mS| undo: %5d mS| redo: %5d mS| %10lld bytes", name.c_str(), count, events, (int) time1, (int) time2, (int) time3, (long long int) undo.capacity());
+}
+ssize_t Undo::capacity() const {
+    auto res = _store->capacity();
+    for (const auto& snapshot : _snapshots) {
+        res += snapshot.second.size;
+    }
+    return res;
 }
 void Undo::clear() {
     _store->clear();
-    _append_len = 0;
-    _break      = 0;
-    _custom1    = Event();
-    _custom2    = "";
-    _group      = 0;
-    _group_lock = false;
-    _prev_type  = 0;
-    _save_point = -1;
-    _time       = 0.0;
+    _snapshot_cut(Undo::SAVE_POINT_NONE);
+    _append_len      = 0;
+    _break           = 0;
+    _custom1         = Event();
+    _custom2         = "";
+    _group           = 0;
+    _group_lock      = false;
+    _prev_type       = 0;
+    _save_point      = -1;
+    _snapshot_events = 0;
+    _time            = 0.0;
 }
 ssize_t Undo::debug(bool all) {
 #ifdef DEBUG
@@ -20549,6 +23906,8 @@ ssize_t Undo::debug(bool all) {
     printf("    group_lock         = %8d\n", _group_lock);
     printf("    prev_type          = %8d\n", _prev_type);
     printf("    save_point         = %8lld\n", (long long int) _save_point);
+    printf("    snapshots          = %8d\n", (int) _snapshots.size());
+    printf("    snapshot_events    = %8d\n", (int) _snapshot_events);
     printf("    time               = %8.2f\n", _time);
     fflush(stdout);
     return res;
@@ -20557,13 +23916,251 @@ ssize_t Undo::debug(bool all) {
     return 0;
 #endif
 }
+bool Undo::Diff(const char* before, size_t before_len, const char* after, size_t after_len, int& pos, std::string& str1, std::string& str2) {
+    auto start = (size_t) 0;
+    auto end   = (size_t) 0;
+    str1.clear();
+    str2.clear();
+    while (start < before_len && start < after_len && before[start] == after[start]) {
+        start++;
+    }
+    while (end < before_len - start && end < after_len - start && before[before_len - end - 1] == after[after_len - end - 1]) {
+        end++;
+    }
+    if (start == before_len && start == after_len) {
+        return false;
+    }
+    auto b1  = before + start;
+    auto b2  = before + before_len - end;
+    auto a1  = after + start;
+    auto a2  = after + after_len - end;
+    auto gap = (size_t) 0;
+    auto rb  = (const char*) nullptr;
+    auto ra  = (const char*) nullptr;
+    pos = static_cast<int>(start);
+    if (std::count(b1, b2, '\n') != std::count(a1, a2, '\n')) {
+        Undo::_DiffHunk(gap, b1, b2, a1, a2, str1, str2);
+        return true;
+    }
+    while (b1 < b2 || a1 < a2) {
+        auto be = static_cast<const char*>(memchr(b1, '\n', b2 - b1));
+        auto ae = static_cast<const char*>(memchr(a1, '\n', a2 - a1));
+        be = (be != nullptr) ? be + 1 : b2;
+        ae = (ae != nullptr) ? ae + 1 : a2;
+        if (be - b1 == ae - a1 && memcmp(b1, a1, be - b1) == 0) {
+            if (rb != nullptr) {
+                gap = Undo::_DiffHunk(gap, rb, b1, ra, a1, str1, str2);
+                rb  = nullptr;
+            }
+            gap += be - b1;
+        }
+        else if (rb == nullptr) {
+            rb = b1;
+            ra = a1;
+        }
+        b1 = be;
+        a1 = ae;
+    }
+    if (rb != nullptr) {
+        Undo::_DiffHunk(gap, rb, b1, ra, a1, str1, str2);
+    }
+    return true;
+}
+bool Undo::DiffApply(const Event& node, bool undo, const char* in, size_t in_len, std::string& out) {
+    auto head = node.c_str1();
+    auto str2 = node.c_str2();
+    auto end  = in + in_len;
+    size_t num[3];
+    out.clear();
+    out.reserve(in_len);
+    while (*head != 0) {
+        head = Undo::_DiffHeader(head, num);
+        if (head == nullptr || static_cast<size_t>(end - in) < num[0] + (undo ? num[2] : num[1])) {
+            return false;
+        }
+        out.append(in, num[0]);
+        in += num[0];
+        if (undo == true) {
+            out.append(head, num[1]);
+            in += num[2];
+        }
+        else {
+            out.append(str2, num[2]);
+            in += num[1];
+        }
+        head += num[1];
+        str2 += num[2];
+    }
+    return in == end;
+}
+ssize_t Undo::DiffSize(const Event& node, bool undo) {
+    auto head = node.c_str1();
+    auto res  = (ssize_t) 0;
+    size_t num[3];
+    while (*head != 0) {
+        head = Undo::_DiffHeader(head, num);
+        if (head == nullptr) {
+            return -1;
+        }
+        res  += num[0] + (undo ? num[2] : num[1]);
+        head += num[1];
+    }
+    return res;
+}
+const char* Undo::_DiffHeader(const char* in, size_t num[3]) {
+    for (auto f = 0; f < 3; f++) {
+        num[f] = 0;
+        if (*in < '0' || *in > '9') {
+            return nullptr;
+        }
+        while (*in >= '0' && *in <= '9') {
+            num[f] = num[f] * 10 + (*in - '0');
+            in++;
+        }
+        if (*in != ((f == 2) ? '\n' : ' ')) {
+            return nullptr;
+        }
+        in++;
+    }
+    return in;
+}
+size_t Undo::_DiffHunk(size_t gap, const char* before, const char* before_end, const char* after, const char* after_end, std::string& str1, std::string& str2) {
+    auto len1  = static_cast<size_t>(before_end - before);
+    auto len2  = static_cast<size_t>(after_end - after);
+    auto start = (size_t) 0;
+    auto end   = (size_t) 0;
+    while (start < len1 && start < len2 && before[start] == after[start]) {
+        start++;
+    }
+    while (end < len1 - start && end < len2 - start && before[len1 - end - 1] == after[len2 - end - 1]) {
+        end++;
+    }
+    str1 += gnu::str::format("%llu %llu %llu\n", (long long unsigned) (gap + start), (long long unsigned) (len1 - start - end), (long long unsigned) (len2 - start - end));
+    str1.append(before + start, len1 - start - end);
+    str2.append(after + start, len2 - start - end);
+    return end;
+}
+ssize_t Undo::raw_capacity() const {
+    auto res = _store->raw_capacity();
+    for (const auto& snapshot : _snapshots) {
+        res += snapshot.second.length;
+    }
+    return res;
+}
+void Undo::restore_save_point() {
+    _snapshot_cut(Undo::SAVE_POINT_NONE);
+    _save_point      = _store->cursor();
+    _group           = static_cast<uint16_t>(peek_undo().group() + 1);
+    _snapshot_events = 0;
+    break_append();
+}
 void Undo::set_save_point() {
     _save_point = _store->cursor();
 }
+void Undo::snapshot_add(char* text, size_t length) {
+    auto cursor = _store->cursor();
+    auto it     = _snapshots.find(cursor);
+    for (auto& snapshot : _snapshots) {
+        _snapshot_ready(snapshot.second, false);
+    }
+    if (it != _snapshots.end()) {
+        _snapshot_erase(it);
+    }
+    auto& snapshot = _snapshots[cursor];
+    snapshot.length  = length;
+    snapshot.size    = length;
+    snapshot.pending = std::async(std::launch::async, [text, length]() {
+        auto res = BlockStore::Compress(text, length);
+        free(text);
+        res.shrink_to_fit();
+        return res;
+    });
+    BlockStore::MEMORY += snapshot.size;
+    _snapshot_events    = 0;
+    break_append();
+    while (_snapshots.size() > Undo::SNAPSHOT_MAX) {
+        it = _snapshots.begin();
+        while (it->first == -1 || it->first == _save_point || it->first == cursor) {
+            ++it;
+        }
+        _snapshot_erase(it);
+    }
+    Undo::SnapshotEvict();
+}
+void Undo::SnapshotEvict() {
+    for (auto undo : Undo::UNDOS) {
+        auto it = undo->_snapshots.begin();
+        while (it != undo->_snapshots.end() && BlockStore::MEMORY > limits::UNDO_MEMORY_ALL_VAL) {
+            if (undo->_snapshot_ready(it->second, false) == false) {
+                ++it;
+            }
+            else {
+                it = undo->_snapshot_erase(it);
+            }
+        }
+    }
+}
+int Undo::snapshot_jump(ssize_t target, bool undo, std::string& text) {
+    auto cursor = _store->cursor();
+    auto it     = _snapshots.end();
+    if (target == Undo::SAVE_POINT_NONE || _snapshots.size() == 0) {
+        return 0;
+    }
+    else if (undo == true) {
+        it = _snapshots.lower_bound(target);
+        if (target >= cursor || it == _snapshots.end() || it->first >= cursor) {
+            return 0;
+        }
+    }
+    else {
+        it = _snapshots.upper_bound(target);
+        if (target <= cursor || it == _snapshots.begin() || (--it)->first <= cursor) {
+            return 0;
+        }
+    }
+    _snapshot_ready(it->second, true);
+    if (BlockStore::Decompress(it->second.data.c_str(), it->second.data.length(), text, it->second.length) == false) {
+        _snapshot_erase(it);
+        return 0;
+    }
+    auto pos   = std::min(cursor, it->first);
+    auto end   = std::max(cursor, it->first);
+    auto count = 0;
+    while (pos < end && _store->go_right(pos) == true) {
+        count++;
+    }
+    _store->seek(it->first);
+    _prev_type = Token::NIL;
+    return count;
+}
+void Undo::_snapshot_cut(ssize_t cursor) {
+    auto it = _snapshots.lower_bound(cursor);
+    while (it != _snapshots.end()) {
+        it = _snapshot_erase(it);
+    }
+}
+std::map<ssize_t, Undo::Snapshot>::iterator Undo::_snapshot_erase(std::map<ssize_t, Snapshot>::iterator it) {
+    BlockStore::MEMORY -= it->second.size;
+    return _snapshots.erase(it);
+}
+bool Undo::_snapshot_ready(Snapshot& snapshot, bool wait) {
+    if (snapshot.pending.valid() == false) {
+        return true;
+    }
+    else if (wait == false && snapshot.pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return false;
+    }
+    snapshot.data       = snapshot.pending.get();
+    BlockStore::MEMORY -= snapshot.size;
+    snapshot.size       = snapshot.data.capacity();
+    BlockStore::MEMORY += snapshot.size;
+    return true;
+}
 void Undo::_push_node_to_buf(Event node) {
     if (_custom1.is_null() == false) {
         _store->go_right_before_cut();
         _store->set_node(_custom1);
+        _snapshot_cut(_store->cursor());
         clear_custom1();
     }
     if (_is_cursor_at_end() == true) {
@@ -20573,14 +24170,19 @@ void Undo::_push_node_to_buf(Event node) {
         _store->go_right_before_cut();
         _store->set_node(node);
     }
+    _snapshot_cut(_store->cursor());
 }
 }
 }
+#include <FL/fl_draw.H>
 #include <FL/Fl_Repeat_Button.H>
 #include <FL/Fl_Return_Button.H>
 namespace fle {
 namespace widgets {
     constexpr static const char*    BUTTON_NL                   = "NL";
+    constexpr static const char*    CHOICE_SCOPE                = "All|Code|Comments|Strings";
+    constexpr static const char*    RESULTLIST_MENU_ALL         = "Copy all Lines";
+    constexpr static const char*    RESULTLIST_MENU_LINE        = "Copy Current Line";
     constexpr static const char*    STATUSBAR_LINE_UNIX         = "Unix";
     constexpr static const char*    STATUSBAR_LINE_WIN          = "Windows";
     constexpr static const char*    STATUSBAR_SPACES_TO_TABS    = "Convert to tabs";
@@ -20609,6 +24211,7 @@ namespace widgets {
     constexpr static const char*    TOOLTIP_FIND_JUMP           = "Jump between find and replace input field with alt+1/2.";
     constexpr static const char*    TOOLTIP_FIND_NL             = "Replace all \\n\\r\\t with actual ascii value in find string.";
     constexpr static const char*    TOOLTIP_FIND_REGEX          = "Use regular expression (PCRE) for search string.";
+    constexpr static const char*    TOOLTIP_FIND_SCOPE          = "Only match text with selected syntax style.\nCode is everything except comments and strings.";
     constexpr static const char*    TOOLTIP_FIND_SELECTION      = "Replace only in selection.\nOnly valid for 'Replace all'!";
     constexpr static const char*    TOOLTIP_FIND_WORD           = "Find whole words only when searching (not for regex).";
     constexpr static const char*    TOOLTIP_REPLACE_NL          = "Replace all \\n\\r\\t with actual ascii value in replace string.";
@@ -20618,13 +24221,16 @@ namespace widgets {
                                                                   "Use $1 to $9.\n"
                                                                   "Example: search for \"(\\w+)\\s+(\\w+)\".\n"
                                                                   "And replace with \"$2 $1\" to swap two words.\n";
+    constexpr static const char*    TOOLTIP_RESULTLIST          = "Right click to show the menu.";
     constexpr static const char*    TOOLTIP_TEST_REGEX          = "Test if string can be compiled by pcre engine.";
 }
 class _AutoCompleteBrowser : public flw::ScrollBrowser {
     std::string                 _selected;
     std::string                 _input;
+    bool                        _ranked;
 public:
     _AutoCompleteBrowser(int X, int Y, int W, int H) : flw::ScrollBrowser(X, Y, W, H) {
+        _ranked = false;
         callback(_AutoCompleteBrowser::Callback2, this);
     }
     static void Callback2(Fl_Widget*, void* o) {
@@ -20682,30 +24288,44 @@ public:
         return flw::ScrollBrowser::handle(event);
     }
     bool find_word() {
-        for (auto f = 1; f <= size(); f++) {
-            auto w = std::string(text(f));
-            if (w.find(_input) == 0) {
-                value(f);
-                topline((f > 1) ? f - 1 : 1);
-                return true;
+        if (_ranked == true) {
+            for (auto f = 1; f <= size(); f++) {
+                if (WordIndex::Score(_input.c_str(), _input.length(), text(f), strlen(text(f))) >= 0) {
+                    value(f);
+                    topline((f > 1) ? f - 1 : 1);
+                    return true;
+                }
+            }
+            return false;
+        }
+        auto first = 1;
+        auto last  = size() + 1;
+        while (first < last) {
+            auto f = first + (last - first) / 2;
+            if (strcmp(text(f), _input.c_str()) < 0) {
+                first = f + 1;
             }
+            else {
+                last = f;
+            }
+        }
+        if (first <= size() && strncmp(text(first), _input.c_str(), _input.length()) == 0) {
+            value(first);
+            topline((first > 1) ? first - 1 : 1);
+            return true;
         }
         return false;
     }
-    int populate(const fle::StringSet& words, std::string word) {
+    int populate(const std::vector<std::string>& words, bool ranked, const std::string& word) {
         clear();
         _selected = "";
-        _input = "";
+        _input    = word;
+        _ranked   = ranked;
         for (const auto& w : words) {
-            if (word.size() == 0) {
-                add(w.c_str());
-            }
-            else if (w.find(word) == 0) {
-                add(w.c_str());
-                if (_input == "") {
-                    _input = word;
-                }
-            }
+            add(w.c_str());
+        }
+        if (size() == 0) {
+            _input = "";
         }
         if (size() > 0) {
             value(1);
@@ -20739,10 +24359,23 @@ int AutoComplete::handle(int event) {
 }
 int AutoComplete::populate(Fl_Fontsize fontsize, const std::set<std::string>& words, const std::string& word, int word_pos) {
     auto browser = static_cast<_AutoCompleteBrowser*>(_browser);
+    auto list    = std::vector<std::string>();
+    _word        = word;
+    _word_pos    = word_pos;
+    for (auto it = words.lower_bound(word); it != words.end() && it->compare(0, word.length(), word) == 0; ++it) {
+        list.push_back(*it);
+    }
+    browser->update_pref(flw::PREF_FIXED_FONT, fontsize);
+    return browser->populate(list, false, word);
+}
+int AutoComplete::populate(Fl_Fontsize fontsize, const WordIndex& words, const TextBuffer& buffer, const std::string& word, int word_pos) {
+    auto browser = static_cast<_AutoCompleteBrowser*>(_browser);
+    auto list    = std::vector<std::string>();
     _word        = word;
     _word_pos    = word_pos;
+    words.complete(word, buffer, word_pos, list);
     browser->update_pref(flw::PREF_FIXED_FONT, fontsize);
-    return browser->populate(words, word);
+    return browser->populate(list, true, word);
 }
 void AutoComplete::popup(int X, int Y, int W, int H) {
     Fl_Group::resize(X, Y, W, H);
@@ -20809,17 +24442,23 @@ void FindBar::update_pref() {
 bool FindBar::visible() const {
     return _statusbar->visible() != 0 || _findreplace->visible() != 0;
 }
-FRegex FindDialog::REGEX = FRegex::NO;
-FTrim  FindDialog::TRIM  = FTrim::NO;
+FCaseCompare FindDialog::CASE  = FCaseCompare::YES;
+FRegex       FindDialog::REGEX = FRegex::NO;
+FScope       FindDialog::SCOPE = FScope::ALL;
+FTerms       FindDialog::TERMS = FTerms::NO;
+FTrim        FindDialog::TRIM  = FTrim::NO;
 FindDialog::FindDialog(const std::string& label, const std::vector<std::string>& find_list) :
 Fl_Double_Window(0, 0, 10, 10) {
     end();
     _cancel  = new Fl_Button(0, 0, 0, 0, "&Cancel");
+    _case    = new Fl_Check_Button(0, 0, 0, 0, "&Match case");
     _find    = new flw::InputMenu(0, 0, 0, 0, "Find");
     _grid    = new flw::GridGroup(0, 0, w(), h());
     _help    = new Fl_Button(0, 0, 0, 0, "&Help");
     _ok      = new Fl_Button(0, 0, 0, 0, "&Find");
     _regex   = new Fl_Check_Button(0, 0, 0, 0, "Rege&x");
+    _scope   = new Fl_Choice(0, 0, 0, 0, "Scope");
+    _terms   = new Fl_Check_Button(0, 0, 0, 0, "Te&rms");
     _test    = new Fl_Button(0, 0, 0, 0, "&Test");
     _trim    = new Fl_Check_Button(0, 0, 0, 0, "&Trim");
     _ret     = false;
@@ -20827,12 +24466,17 @@ Fl_Double_Window(0, 0, 10, 10) {
     _grid->add(_find,     10,   1,  -1,   4, _find->input());
     _grid->add(_regex,    10,   6,  15,   4);
     _grid->add(_trim,     25,   6,  15,   4);
+    _grid->add(_terms,    40,   6,  15,   4);
+    _grid->add(_case,     55,   6,  20,   4);
+    _grid->add(_scope,    10,  11,  30,   4);
     _grid->add(_help,      1,   -5,  16,   4);
     _grid->add(_test,    -51,  -5,  16,   4);
     _grid->add(_cancel,  -34,  -5,  16,   4);
     _grid->add(_ok,      -17,  -5,  16,   4);
     add(_grid);
     _cancel->callback(FindDialog::Callback, this);
+    _case->tooltip("Use case sensitive search for terms (ASCII only).");
+    _case->value(FindDialog::CASE == FCaseCompare::YES);
     _find->align(FL_ALIGN_LEFT);
     _find->callback(FindDialog::Callback, this);
     _find->values(find_list);
@@ -20845,6 +24489,13 @@ Fl_Double_Window(0, 0, 10, 10) {
     _regex->callback(FindDialog::Callback, this);
     _regex->tooltip(widgets::TOOLTIP_FIND_REGEX);
     _regex->value(FindDialog::REGEX == FRegex::YES);
+    _scope->add(widgets::CHOICE_SCOPE);
+    _scope->align(FL_ALIGN_LEFT);
+    _scope->tooltip(widgets::TOOLTIP_FIND_SCOPE);
+    _scope->value(static_cast<int>(FindDialog::SCOPE));
+    _terms->callback(FindDialog::Callback, this);
+    _terms->tooltip("Find lines that contain any of the terms.\nSeparate terms with spaces.");
+    _terms->value(FindDialog::TERMS == FTerms::YES);
     _test->tooltip(widgets::TOOLTIP_TEST_REGEX);
     _test->callback(FindDialog::Callback, this);
     _trim->tooltip("Remove all whitespace from each end of found lines.");
@@ -20855,7 +24506,7 @@ Fl_Double_Window(0, 0, 10, 10) {
     callback(FindDialog::Callback, this);
     set_modal();
     resizable(this);
-    resize(0, 0, flw::PREF_FONTSIZE * 44, flw::PREF_FONTSIZE * 8);
+    resize(0, 0, flw::PREF_FONTSIZE * 44, flw::PREF_FONTSIZE * 10.5);
 }
 void FindDialog::Callback(Fl_Widget* w, void* o) {
     auto* self = static_cast<FindDialog*>(o);
@@ -20872,20 +24523,35 @@ void FindDialog::Callback(Fl_Widget* w, void* o) {
             self->_find->take_focus();
         }
         else {
+            FindDialog::CASE  = (self->_case->value() != 0) ? FCaseCompare::YES : FCaseCompare::NO;
             FindDialog::REGEX = (self->_regex->value() != 0) ? FRegex::YES : FRegex::NO;
+            FindDialog::SCOPE = static_cast<FScope>(self->_scope->value());
+            FindDialog::TERMS = (self->_terms->value() != 0) ? FTerms::YES : FTerms::NO;
             FindDialog::TRIM  = (self->_trim->value() != 0) ? FTrim::YES : FTrim::NO;
             self->_ret        = true;
             self->_run        = false;
             self->hide();
         }
     }
-    else if (w == self->_regex) {
+    else if (w == self->_regex || w == self->_terms) {
+        if (w == self->_regex && self->_regex->value() != 0) {
+            self->_terms->value(0);
+        }
+        else if (w == self->_terms && self->_terms->value() != 0) {
+            self->_regex->value(0);
+        }
         if (self->_regex->value() != 0) {
             self->_test->activate();
         }
         else {
             self->_test->deactivate();
         }
+        if (self->_terms->value() != 0) {
+            self->_case->activate();
+        }
+        else {
+            self->_case->deactivate();
+        }
     }
     else if (w == self->_test) {
         self->test_pcre();
@@ -20930,10 +24596,12 @@ _config(config) {
     _replace_all   = new Fl_Button(0, 0, 0, 0, "Replace &All");
     _replace_input = new flw::InputMenu(0, 0, 0, 0, "Replace:");
     _replace_nl    = new Fl_Check_Button(0, 0, 0, 0, widgets::BUTTON_NL);
+    _scope         = new Fl_Choice(0, 0, 0, 0);
     _selection     = new Fl_Check_Button(0, 0, 0, 0, "&Selection");
     _word          = new Fl_Check_Button(0, 0, 0, 0, "&Word");
-    add(_find_input,     10, -10, -67,   4, _find_input->input());
-    add(_replace_input,  10,  -5, -67,   4, _replace_input->input());
+    add(_find_input,     10, -10, -79,   4, _find_input->input());
+    add(_replace_input,  10,  -5, -79,   4, _replace_input->input());
+    add(_scope,         -78, -10,  12,   4);
     add(_find_nl,       -66, -10,   8,   4);
     add(_replace_nl,    -66,  -5,   8,   4);
     add(_case,          -58, -10,  10,   4);
@@ -20946,7 +24614,8 @@ _config(config) {
     add(_replace_all,   -17,  -5,  16,   4);
     _case->tooltip(widgets::TOOLTIP_FIND_CASE);
     _find_input->align(FL_ALIGN_LEFT);
-    _find_input->tooltip("Enter search string or regular expression.");
+    _find_input->input()->when(FL_WHEN_CHANGED | FL_WHEN_ENTER_KEY_ALWAYS);
+    _find_input->tooltip("Enter search string or regular expression.\nMatching text is selected while typing.");
     _find_next->tooltip("Find next word.");
     _find_nl->tooltip(widgets::TOOLTIP_FIND_NL);
     _find_prev->tooltip("Find previous word.");
@@ -20960,6 +24629,9 @@ _config(config) {
     _replace_input->align(FL_ALIGN_LEFT);
     _replace_input->tooltip(widgets::TOOLTIP_REPLACE_REGEX);
     _replace_nl->tooltip(widgets::TOOLTIP_REPLACE_NL);
+    _scope->add(widgets::CHOICE_SCOPE);
+    _scope->tooltip(widgets::TOOLTIP_FIND_SCOPE);
+    _scope->value(0);
     _selection->callback(FindReplace::CallbackCheckButton, this);
     _selection->tooltip(widgets::TOOLTIP_FIND_SELECTION);
     _word->tooltip(widgets::TOOLTIP_FIND_WORD);
@@ -21114,6 +24786,7 @@ void GotoLine::popup(int fs, int X, int Y, int W, int H) {
 FCaseCompare ReplaceDialog::CASECOMPARE = FCaseCompare::NO;
 FNlTab       ReplaceDialog::NLTAB       = FNlTab::NO;
 FRegex       ReplaceDialog::REGEX       = FRegex::NO;
+FScope       ReplaceDialog::SCOPE       = FScope::ALL;
 FSelection   ReplaceDialog::SELECTION   = FSelection::NO;
 FWordCompare ReplaceDialog::WORDCOMPARE = FWordCompare::NO;
 ReplaceDialog::ReplaceDialog(const std::string& label, std::string& find, std::string& replace, const std::vector<std::string>& find_list, const std::vector<std::string>& replace_list) :
@@ -21131,6 +24804,7 @@ _replace(replace) {
     _regex         = new Fl_Check_Button(0, 0, 0, 0, "Rege&x");
     _replace_input = new flw::InputMenu(0, 0, 0, 0, "Replace");
     _replace_nl    = new Fl_Check_Button(0, 0, 0, 0, widgets::BUTTON_NL);
+    _scope         = new Fl_Choice(0, 0, 0, 0);
     _selection     = new Fl_Check_Button(0, 0, 0, 0, "&Selection");
     _test          = new Fl_Button(0, 0, 0, 0, "&Test");
     _word          = new Fl_Check_Button(0, 0, 0, 0, "&Word");
@@ -21144,6 +24818,7 @@ _replace(replace) {
     _grid->add(_word,           25,  11,  15,   4);
     _grid->add(_selection,      40,  11,  15,   4);
     _grid->add(_regex,          55,  11,  15,   4);
+    _grid->add(_scope,          70,  11,  -8,   4);
     _grid->add(_help,            1,  -5,  16,   4);
     _grid->add(_cancel,        -51,  -5,  16,   4);
     _grid->add(_test,          -34,  -5,  16,   4);
@@ -21170,6 +24845,9 @@ _replace(replace) {
     _replace_input->tooltip(widgets::TOOLTIP_REPLACE_REGEX);
     _replace_nl->tooltip(widgets::TOOLTIP_REPLACE_NL);
     _replace_nl->value(ReplaceDialog::NLTAB == FNlTab::YES || ReplaceDialog::NLTAB == FNlTab::REPLACE);
+    _scope->add(widgets::CHOICE_SCOPE);
+    _scope->tooltip(widgets::TOOLTIP_FIND_SCOPE);
+    _scope->value(static_cast<int>(ReplaceDialog::SCOPE));
     _selection->callback(ReplaceDialog::Callback, this);
     _selection->tooltip(widgets::TOOLTIP_FIND_SELECTION);
     _selection->value(ReplaceDialog::SELECTION == FSelection::YES);
@@ -21226,6 +24904,7 @@ void ReplaceDialog::Callback(Fl_Widget* w, void* o) {
             }
             ReplaceDialog::CASECOMPARE = (self->_case->value() != 0 && self->_case->active() != 0) ? FCaseCompare::YES : FCaseCompare::NO;
             ReplaceDialog::REGEX       = (self->_regex->value() != 0 && self->_regex->active() != 0) ? FRegex::YES : FRegex::NO;
+            ReplaceDialog::SCOPE       = static_cast<FScope>(self->_scope->value());
             ReplaceDialog::SELECTION   = (self->_selection->value() != 0 && self->_selection->active() != 0) ? FSelection::YES : FSelection::NO;
             ReplaceDialog::WORDCOMPARE = (self->_word->value() != 0 && self->_word->active() != 0) ? FWordCompare::YES : FWordCompare::NO;
             self->hide();
@@ -21284,6 +24963,78 @@ bool ReplaceDialog::test_pcre() {
     }
     return true;
 }
+ResultList::ResultList() : Fl_Browser_(0, 0, 0, 0) {
+    end();
+    _menu     = new Fl_Menu_Button(0, 0, 0, 0);
+    _selected = 0;
+    static_cast<Fl_Group*>(this)->add(_menu);
+    _menu->add(widgets::RESULTLIST_MENU_LINE, 0, ResultList::Callback, this);
+    _menu->add(widgets::RESULTLIST_MENU_ALL, 0, ResultList::Callback, this);
+    _menu->type(Fl_Menu_Button::POPUP3);
+    type(FL_HOLD_BROWSER);
+    tooltip(widgets::TOOLTIP_RESULTLIST);
+    update_pref(flw::PREF_FONT, flw::PREF_FONTSIZE);
+}
+void ResultList::Callback(Fl_Widget*, void* o) {
+    auto self  = static_cast<ResultList*>(o);
+    auto txt   = self->_menu->text();
+    auto label = std::string((txt != nullptr) ? txt : "");
+    auto clip  = std::string();
+    if (label == widgets::RESULTLIST_MENU_LINE) {
+        clip = self->text(self->value());
+    }
+    else if (label == widgets::RESULTLIST_MENU_ALL) {
+        clip.reserve(self->size() * 40 + 100);
+        for (auto f = 1; f <= self->size(); f++) {
+            clip += self->text(f);
+            clip += "\n";
+        }
+    }
+    if (clip != "") {
+        Fl::copy(clip.c_str(), clip.length(), 2);
+    }
+}
+int ResultList::handle(int event) {
+    if (event == FL_PUSH && Fl::event_button() == FL_RIGHT_MOUSE) {
+        _menu->popup();
+        return 1;
+    }
+    return Fl_Browser_::handle(event);
+}
+void ResultList::item_draw(void* item, int X, int Y, int, int H) const {
+    auto text = _results.format(_row(item) - 1);
+    auto col  = (item_selected(item) != 0) ? fl_contrast(textcolor(), selection_color()) : textcolor();
+    fl_font(textfont(), textsize());
+    fl_color((active_r() != 0) ? col : fl_inactive(col));
+    fl_draw(text.c_str(), static_cast<int>(text.length()), X + 3, Y + H - fl_descent() - 1);
+}
+int ResultList::item_height(void*) const {
+    fl_font(textfont(), textsize());
+    return fl_height() + 2;
+}
+int ResultList::item_width(void* item) const {
+    auto text = _results.format(_row(item) - 1);
+    fl_font(textfont(), textsize());
+    return static_cast<int>(fl_width(text.c_str(), static_cast<int>(text.length()))) + 6;
+}
+void ResultList::update_pref(Fl_Font text_font, Fl_Fontsize text_size) {
+    labelfont(flw::PREF_FONT);
+    labelsize(flw::PREF_FONTSIZE);
+    textfont(text_font);
+    textsize(text_size);
+    _menu->textfont(text_font);
+    _menu->textsize(text_size);
+    redraw();
+}
+void ResultList::value(int row) {
+    if (row >= 1 && row <= size()) {
+        select_only(_item(row), 0);
+    }
+    else {
+        deselect(0);
+        _selected = 0;
+    }
+}
 #define FLE_STATUSBAR_CB(X) [](Fl_Widget*, void* o) { static_cast<StatusBar*>(o)->X; }, this
 StatusBar::StatusBar(Config& config) :
 flw::GridGroup(),
@@ -22877,6 +26628,8 @@ class _TweakDialog : public Fl_Double_Window {
     Fl_Hor_Slider*              _out_line_length;
     Fl_Hor_Slider*              _scroll;
     Fl_Hor_Slider*              _style_size;
+    Fl_Hor_Slider*              _undo_memory;
+    Fl_Hor_Slider*              _undo_memory_all;
     Fl_Hor_Slider*              _wrap_length;
     flw::GridGroup*             _grid;
     bool                        _run;
@@ -22900,6 +26653,8 @@ public:
         _save             = new Fl_Button(0, 0, 0, 0, "Save");
         _scroll           = new Fl_Hor_Slider(0, 0, 0, 0);
         _style_size       = new Fl_Hor_Slider(0, 0, 0, 0);
+        _undo_memory      = new Fl_Hor_Slider(0, 0, 0, 0);
+        _undo_memory_all  = new Fl_Hor_Slider(0, 0, 0, 0);
         _wrap_length      = new Fl_Hor_Slider(0, 0, 0, 0);
         _run              = false;
         _grid->add(_force,              1,   1,  -1,   4);
@@ -22914,7 +26669,9 @@ public:
         _grid->add(_wrap_length,        1,  72,  -1,   4);
         _grid->add(_count_char,         1,  80,  -1,   4);
         _grid->add(_scroll,             1,  88,  -1,   4);
-        _grid->add(_label,              1,  94,  -1,  10);
+        _grid->add(_undo_memory,        1,  96,  -1,   4);
+        _grid->add(_undo_memory_all,    1, 104,  -1,   4);
+        _grid->add(_label,              1, 110,  -1,  10);
         _grid->add(_reset,            -51,  -5,  16,   4);
         _grid->add(_save,             -34,  -5,  16,   4);
         _grid->add(_close,            -17,  -5,  16,   4);
@@ -23010,6 +26767,22 @@ public:
         _style_size->precision(0);
         _style_size->step((int) limits::STYLE_FILESIZE_STEP);
         _style_size->value(limits::STYLE_FILESIZE_VAL);
+        _undo_memory->align(FL_ALIGN_TOP | FL_ALIGN_LEFT);
+        _undo_memory->callback(_TweakDialog::Callback, this);
+        _undo_memory->color(FL_BACKGROUND2_COLOR);
+        _undo_memory->range(limits::UNDO_MEMORY_MIN, limits::UNDO_MEMORY_MAX);
+        _undo_memory->precision(0);
+        _undo_memory->step((int) limits::UNDO_MEMORY_STEP);
+        _undo_memory->value(limits::UNDO_MEMORY_VAL);
+        _undo_memory->tooltip("Older undo history is moved to a temporary file when an editor uses more memory than this.\nOnly the compressed undo store is limited, the other stores show a warning instead.");
+        _undo_memory_all->align(FL_ALIGN_TOP | FL_ALIGN_LEFT);
+        _undo_memory_all->callback(_TweakDialog::Callback, this);
+        _undo_memory_all->color(FL_BACKGROUND2_COLOR);
+        _undo_memory_all->range(limits::UNDO_MEMORY_ALL_MIN, limits::UNDO_MEMORY_ALL_MAX);
+        _undo_memory_all->precision(0);
+        _undo_memory_all->step((int) limits::UNDO_MEMORY_ALL_STEP);
+        _undo_memory_all->value(limits::UNDO_MEMORY_ALL_VAL);
+        _undo_memory_all->tooltip("Older undo history is moved to temporary files when all editors together use more memory than this.\nOnly the compressed undo store is limited, the other stores show a warning instead.");
         _wrap_length->align(FL_ALIGN_TOP | FL_ALIGN_LEFT);
         _wrap_length->callback(_TweakDialog::Callback, this);
         _wrap_length->color(FL_BACKGROUND2_COLOR);
@@ -23027,12 +26800,14 @@ public:
         _TweakDialog::Callback(_out_lines, this);
         _TweakDialog::Callback(_scroll, this);
         _TweakDialog::Callback(_style_size, this);
+        _TweakDialog::Callback(_undo_memory, this);
+        _TweakDialog::Callback(_undo_memory_all, this);
         _TweakDialog::Callback(_wrap_length, this);
         callback(_TweakDialog::Callback, this);
         copy_label(fle::APPLICATION != "" ? (fle::APPLICATION + " - Tweaks").c_str() : "Tweaks");
         set_modal();
         resizable(_grid);
-        size(flw::PREF_FONTSIZE * 48, flw::PREF_FONTSIZE * 56);
+        size(flw::PREF_FONTSIZE * 48, flw::PREF_FONTSIZE * 64);
         flw::util::center_window(this, Fl::first_window());
         _grid->do_layout();
     }
@@ -23051,7 +26826,7 @@ public:
             self->update();
         }
         else if (w == self->_auto_file_size) {
-            auto l = gnu::str::format("Max file size for autocomplete: %s", gnu::str::format_int(self->_auto_file_size->value()).c_str());
+            auto l = gnu::str::format("Max bytes scanned for autocomplete: %s", gnu::str::format_int(self->_auto_file_size->value()).c_str());
             self->_auto_file_size->copy_label(l.c_str());
             self->redraw();
         }
@@ -23081,7 +26856,7 @@ public:
             self->redraw();
         }
         else if (w == self->_out_lines) {
-            auto l = gnu::str::format("Max lines for output: %s", gnu::str::format_int(self->_out_lines->value()).c_str());
+            auto l = gnu::str::format("Max lines for output: %s", (self->_out_lines->value() < 1.0) ? "unlimited" : gnu::str::format_int(self->_out_lines->value()).c_str());
             self->_out_lines->copy_label(l.c_str());
             self->redraw();
         }
@@ -23100,6 +26875,16 @@ public:
             self->_style_size->copy_label(l.c_str());
             self->redraw();
         }
+        else if (w == self->_undo_memory) {
+            auto l = gnu::str::format("Max undo memory for one editor: %s", gnu::str::format_int(self->_undo_memory->value()).c_str());
+            self->_undo_memory->copy_label(l.c_str());
+            self->redraw();
+        }
+        else if (w == self->_undo_memory_all) {
+            auto l = gnu::str::format("Max undo memory for all editors: %s", gnu::str::format_int(self->_undo_memory_all->value()).c_str());
+            self->_undo_memory_all->copy_label(l.c_str());
+            self->redraw();
+        }
         else if (w == self->_wrap_length) {
             auto l = gnu::str::format("Max line length before wrap is turned on file load: %s", gnu::str::format_int(self->_wrap_length->value()).c_str());
             self->_wrap_length->copy_label(l.c_str());
@@ -23118,6 +26903,8 @@ public:
         limits::OUTPUT_LINE_LENGTH_VAL     = limits::OUTPUT_LINE_LENGTH_DEF;
         limits::SCROLL_VAL                 = limits::SCROLL_DEF;
         limits::STYLE_FILESIZE_VAL         = limits::STYLE_FILESIZE_DEF;
+        limits::UNDO_MEMORY_ALL_VAL        = limits::UNDO_MEMORY_ALL_DEF;
+        limits::UNDO_MEMORY_VAL            = limits::UNDO_MEMORY_DEF;
         limits::WRAP_LINE_LENGTH_VAL       = limits::WRAP_LINE_LENGTH_DEF;
         _force->value(limits::FORCE_RESTYLING);
         _auto_file_size->value(limits::AUTOCOMPLETE_FILESIZE_VAL);
@@ -23130,6 +26917,8 @@ public:
         _out_lines->value(limits::OUTPUT_LINES_VAL);
         _scroll->value(limits::SCROLL_VAL);
         _style_size->value(limits::STYLE_FILESIZE_VAL);
+        _undo_memory->value(limits::UNDO_MEMORY_VAL);
+        _undo_memory_all->value(limits::UNDO_MEMORY_ALL_VAL);
         _wrap_length->value(limits::WRAP_LINE_LENGTH_VAL);
         _TweakDialog::Callback(_auto_file_size, this);
         _TweakDialog::Callback(_auto_lines, this);
@@ -23141,6 +26930,8 @@ public:
         _TweakDialog::Callback(_out_lines, this);
         _TweakDialog::Callback(_scroll, this);
         _TweakDialog::Callback(_style_size, this);
+        _TweakDialog::Callback(_undo_memory, this);
+        _TweakDialog::Callback(_undo_memory_all, this);
         _TweakDialog::Callback(_wrap_length, this);
         _label->label("Settings has been reset to default values.");
     }
@@ -23164,6 +26955,8 @@ public:
         limits::OUTPUT_LINE_LENGTH_VAL     = _out_line_length->value();
         limits::SCROLL_VAL                 = _scroll->value();
         limits::STYLE_FILESIZE_VAL         = _style_size->value();
+        limits::UNDO_MEMORY_ALL_VAL        = _undo_memory_all->value();
+        limits::UNDO_MEMORY_VAL            = _undo_memory->value();
         limits::WRAP_LINE_LENGTH_VAL       = _wrap_length->value();
         _label->label("Settings has been updated.");
     }
@@ -23185,6 +26978,7 @@ void View::draw() {
     auto& buf2 = _editor->style_buffer();
     if (_config.pref_highlight == false || buf2.length() == 0) {
         Fl_Text_Editor::draw();
+        _draw_matches();
         return;
     }
     auto  pos   = insert_position();
@@ -23211,6 +27005,31 @@ void View::draw() {
         Fl_Text_Editor::draw();
         buf2.poke(pos, c);
     }
+    _draw_matches();
+}
+void View::_draw_matches() {
+    auto& matches = _editor->matches();
+    if (matches.is_empty() == true || _editor->findreplace().visible() == 0) {
+        return;
+    }
+    auto ranges = RangeVector();
+    matches.visible(mFirstChar, mLastChar, ranges);
+    fl_push_clip(text_area.x, text_area.y, text_area.w, text_area.h);
+    fl_color(cursor_color());
+    for (const auto& range : ranges) {
+        auto x1 = 0;
+        auto y1 = 0;
+        auto x2 = 0;
+        auto y2 = 0;
+        if (position_to_xy(std::max(range.first, mFirstChar), &x1, &y1) == 0) {
+            continue;
+        }
+        if (position_to_xy(range.second, &x2, &y2) == 0 || y2 != y1) {
+            x2 = text_area.x + text_area.w;
+        }
+        fl_rect(x1, y1, std::max(x2 - x1, 2), mMaxsize);
+    }
+    fl_pop_clip();
 }
 View::~View() {
     buffer(nullptr);
@@ -23831,14 +27650,13 @@ _editor_flags() {
     _findbar      = findbar;
     _autocomplete = nullptr;
     _custom       = nullptr;
-    _regex        = new gnu::pcre8::PCRE();
     _buf1         = new TextBuffer(this, _config);
     _buf2         = new TextBuffer(nullptr, _config);
     _editors      = new flw::SplitGroup();
     _goto         = new GotoLine();
     _main         = new flw::SplitGroup();
     _menu         = new Fl_Menu_Button(0, 0, 0, 0);
-    _output       = new flw::ScrollBrowser();
+    _output       = new ResultList();
     _view1        = new View(_config, this);
     _view2        = nullptr;
     _view         = _view1;
@@ -23856,6 +27674,7 @@ _editor_flags() {
     _output->when(FL_WHEN_ENTER_KEY_CHANGED);
     _findbar->findreplace().hide();
     _goto->callback(Editor::CallbackGoto, this);
+    _buf1->add_modify_callback(Editor::CallbackModify, this);
     callback_connect();
     if (_config.active == nullptr) {
         _config.active = this;
@@ -23868,6 +27687,10 @@ _editor_flags() {
     box(FL_THIN_DOWN_BOX);
 }
 Editor::~Editor() {
+    Fl::remove_timeout(Editor::CallbackIncremental, this);
+    Fl::remove_timeout(Editor::CallbackWords, this);
+    _isearch.invalidate();
+    _words.cancel();
     if (_config.active == this) {
         _config.active = nullptr;
     }
@@ -23876,7 +27699,6 @@ Editor::~Editor() {
     _view2 = nullptr;
     _editors->add(nullptr, true);
     _editors->add(nullptr, false);
-    delete _regex;
     delete _style;
     delete _buf1;
     delete _buf2;
@@ -23895,14 +27717,17 @@ void Editor::autocomplete_callback() {
     auto word     = _autocomplete->word();
     auto word_pos = _autocomplete->word_pos();
     if (selected != "" && selected != word && word_pos <= text_length()) {
-        auto start = selected.find(word);
-        if (start != std::string::npos) {
+        auto start = word_pos;
+        if (selected.compare(0, word.length(), word) == 0) {
            selected.erase(0, word.length());
         }
+        else {
+            start -= static_cast<int>(word.length());
+        }
         auto i = _buf1->get_indent(word_pos);
         gnu::str::replace(selected, "|", std::string("\n") + i);
-        _buf1->insert(word_pos, selected.c_str());
-        cursor_move_to_pos(word_pos + selected.size(), true);
+        _buf1->replace(start, word_pos, selected.c_str());
+        cursor_move_to_pos(start + selected.size(), true);
     }
     autocomplete_remove();
 }
@@ -23936,10 +27761,10 @@ void Editor::autocomplete_show() {
     _autocomplete = new AutoComplete("autocomplete");
     auto word     = _buf1->get_letters_to_left(cursor_insert_position());
     add(_autocomplete);
-    if (_words.size() == 0 || _view->position_to_xy(pos, &X, &Y) == 0) {
+    if (_words.is_active() == false || _view->position_to_xy(pos, &X, &Y) == 0) {
         return autocomplete_remove();
     }
-    else if (_autocomplete->populate(fs, _words, word, pos) == 0) {
+    else if (_autocomplete->populate(fs, _words, *_buf1, word, pos) == 0) {
         return autocomplete_remove();
     }
     if (X + W > x() + w()) {
@@ -24021,7 +27846,12 @@ void Editor::CallbackFind(Fl_Widget* w, void* o) {
     if (self->text_is_readonly() == true) {
         self->statusbar_set_message(errors::TEXT_IS_READ_ONLY);
     }
+    else if (w == f.find_input() && Fl::event_key() != FL_Enter && Fl::event_key() != FL_KP_Enter) {
+        self->find_incremental();
+    }
     else if (w == f.find_input()) {
+        Fl::remove_timeout(Editor::CallbackIncremental, o);
+        self->_isearch.invalidate();
         self->find_replace(self->_editor_flags.fsearchdir);
     }
     else if (w == f.next_button()) {
@@ -24036,7 +27866,7 @@ void Editor::CallbackFind(Fl_Widget* w, void* o) {
         self->find_replace(self->_editor_flags.fsearchdir, true);
     }
     else if (w == f.replace_all_button()) {
-        self->find_replace_all(f.find_string(), f.replace_string(), f.fnltab(), f.fselection(), f.fcasecompare(), f.fwordcompare(), f.fregex(), FSaveWord::YES, FHideFind::YES);
+        self->find_replace_all(f.find_string(), f.replace_string(), f.fnltab(), f.fselection(), f.fcasecompare(), f.fwordcompare(), f.fregex(), f.fscope(), FSaveWord::YES, FHideFind::YES);
     }
     else if (w == f.replace_input()) {
         self->find_replace(self->_editor_flags.fsearchdir, true);
@@ -24046,13 +27876,74 @@ void Editor::CallbackGoto(Fl_Widget*, void* o) {
     auto self = static_cast<Editor*>(o);
     self->goto_callback();
 }
+void Editor::CallbackIncremental(void* o) {
+    auto self  = static_cast<Editor*>(o);
+    auto start = 0;
+    auto end   = 0;
+    if (self->_isearch.copy(*self->_buf1, IncrementalSearch::COPY) == false) {
+        self->_isearch.invalidate();
+        return;
+    }
+    else if (self->_isearch.take_nearest(start, end) == true) {
+        auto cursor = self->cursor(false);
+        cursor.pos1  = end;
+        cursor.start = start;
+        cursor.end   = end;
+        cursor.set_drag();
+        self->cursor_move(cursor);
+        self->_view->display_insert();
+    }
+    if (self->_isearch.is_done() == false) {
+        self->statusbar_set_message(gnu::str::format(info::SEARCHING.c_str(), self->_isearch.find_string().c_str(), self->_isearch.count()));
+        Fl::repeat_timeout(0.05, Editor::CallbackIncremental, o);
+    }
+    else if (self->_isearch.count() == 0) {
+        self->_matches.clear();
+        self->redraw();
+        self->statusbar_set_message(gnu::str::format(info::NO_STRING_FOUND.c_str(), self->_isearch.find_string().c_str()));
+    }
+    else {
+        auto ranges = RangeVector();
+        if (self->_isearch.take_ranges(ranges) == true) {
+            self->_matches.set(self->_isearch.find_string(), self->_isearch.match_case(), self->_isearch.regex(), ranges);
+        }
+        else {
+            self->_matches.clear();
+        }
+        self->redraw();
+        self->statusbar_set_message(gnu::str::format(info::FOUND_STRINGS.c_str(), self->_isearch.count(), self->_isearch.find_string().c_str(), (int) (gnu::Time::Milli() - self->_isearch.start_time())));
+    }
+}
+void Editor::CallbackModify(int pos, int inserted_size, int deleted_size, int, const char* deleted_text, void* o) {
+    auto self = static_cast<Editor*>(o);
+    if (inserted_size == 0 && deleted_size == 0) {
+        return;
+    }
+    if (self->_isearch.has_snapshot() == true) {
+        Fl::remove_timeout(Editor::CallbackIncremental, o);
+        self->_isearch.invalidate();
+    }
+    if (self->_matches.update(*self->_buf1, pos, inserted_size, deleted_size) == true) {
+        self->redraw();
+    }
+    self->_words.update(*self->_buf1, pos, inserted_size, deleted_size, deleted_text);
+    if (self->_words.is_building() == true && Fl::has_timeout(Editor::CallbackWords, o) == 0) {
+        Fl::add_timeout(0.05, Editor::CallbackWords, o);
+    }
+}
 void Editor::CallbackOutput(Fl_Widget*, void* o) {
     auto self = static_cast<Editor*>(o);
     self->callback_output();
 }
+void Editor::CallbackWords(void* o) {
+    auto self = static_cast<Editor*>(o);
+    if (self->_words.publish() == false) {
+        Fl::repeat_timeout(0.05, Editor::CallbackWords, o);
+    }
+}
 void Editor::callback_output(int add_line) {
     auto row = _output->value();
-    if (_regex->is_compiled() == false) {
+    if (_output->size() == 0) {
         return;
     }
     row += add_line;
@@ -24062,16 +27953,10 @@ void Editor::callback_output(int add_line) {
     else if (row > _output->size()) {
         row = 1;
     }
-    if (row <= _output->size()) {
-        auto text1   = _output->text(row);
-        auto matches = _regex->exec(text1);
-        _output->value(row);
-        if (matches.size() > 1) {
-            auto line = gnu::str::to_int(_regex->match("line").word());
-            auto col  = gnu::str::to_int(_regex->match("col").word());
-            cursor_move_to_rowcol(line, col);
-            take_focus();
-        }
+    _output->value(row);
+    if (_output->results().has_location(row - 1) == true) {
+        cursor_move_to_rowcol(_output->results().line(row - 1), _output->results().col(row - 1));
+        take_focus();
     }
 }
 int Editor::count_lines() const {
@@ -24271,8 +28156,8 @@ void Editor::debug(int what) {
         }
     }
     else {
-        size_t b, s, u;
-        auto t = memory_usage(b, s, u);
+        size_t b, s, u, r;
+        auto t = memory_usage(b, s, u, r);
         printf("\nflw:\n");
         printf("    FONT               = %2d\n", flw::PREF_FONT);
         printf("    FONTNAME           = '%s'\n", flw::PREF_FONTNAME.c_str());
@@ -24290,10 +28175,12 @@ void Editor::debug(int what) {
         printf("    id                 = %9d\n", object_id());
         printf("    autocomplete words = %9d\n", (int) _words.size());
         printf("    changed_name       = '%s'\n", filename_short_changed().c_str());
-        printf("    output_regex       = %9d\n", _regex ? 1 : 0);
+        printf("    output_lines       = %9d\n", _output->size());
         printf("    buffer length      = %9llu\n", (long long unsigned) b);
         printf("    style length       = %9llu\n", (long long unsigned) s);
         printf("    undo capacity      = %9llu\n", (long long unsigned) u);
+        printf("    undo uncompressed  = %9llu\n", (long long unsigned) r);
+        printf("    undo ratio         = %9.2f\n", (u > 0) ? (double) r / u : 1.0);
         printf("    total              = %9llu\n", (long long unsigned) t);
         printf("\nView:\n");
         printf("    view               = %9s\n", _view == _view1 ? _view2 ? "view1 (view2)" : "view1" : "view2 (view1)");
@@ -24515,7 +28402,9 @@ std::string Editor::file_load(const std::string& filename, bool force_hex) {
         dirty = true;
     }
     text_set_dirty(dirty, true);
-    update_autocomplete(fbuf.c_str());
+    if (_file_info.binary == true || (_words.is_active() == false && _words.is_building() == false)) {
+        update_autocomplete();
+    }
     _config.send_message(message::FILE_LOADED, "", "", this);
     return "";
 }
@@ -24546,12 +28435,16 @@ std::string Editor::file_save() {
     else {
         saved = gnu::file::write(filename_long(), text1);
     }
-    update_autocomplete(text1.c_str());
     if (saved == false) {
         _buf1->checksum_clear();
         return statusbar_set_message(gnu::str::format(errors::SAVE_FILE.c_str(), _file_info.fi.c_str()));
     }
-    _buf1->set_save_point();
+    if (file_line_ending() == FLineEnding::UNIX && text1.size() == static_cast<size_t>(text_length())) {
+        _buf1->set_save_point(text1.release());
+    }
+    else {
+        _buf1->set_save_point();
+    }
     _file_info.fi = gnu::file::File(_file_info.fi.filename());
     gnu::file::chmod(filename_long(), fi.mode());
     text_set_dirty(false);
@@ -24564,37 +28457,67 @@ std::string Editor::file_save_as(const std::string& filename) {
     _file_info.fi = gnu::file::File(filename);
     return file_save();
 }
-size_t Editor::find_lines(const std::string& find, FRegex fregex, FTrim ftrim) {
-    auto out   = (flw::ScrollBrowser*) _output;
-    auto time  = gnu::Time::Milli();
-    auto lines = std::vector<std::string>();
-    auto rx    = (fregex == FRegex::YES) ? new gnu::pcre8::PCRE(find, true) : nullptr;
-    _buf1->find_lines("", find, rx, ftrim, lines);
-    out->clear();
-    if (lines.size() > 0) {
-        for (const auto& line : lines) {
-            out->add(line.c_str());
-        }
-        _regex->compile("\\s*(?<line>\\d+)\\s+-\\s+(?<col>\\d+)|.*", true);
-        _regex->set_names({"line", "col"});
+size_t Editor::find_lines(const std::string& find, FRegex fregex, FTerms fterms, FCaseCompare fcase, FScope fscope, FTrim ftrim) {
+    if (_buf1->has_scope_style(fscope) == false) {
+        fl_beep(FL_BEEP_ERROR);
+        statusbar_set_message(info::NOT_STYLED);
+        return 0;
+    }
+    auto time    = gnu::Time::Milli();
+    auto results = ResultStore();
+    auto rx      = (fregex == FRegex::YES) ? new gnu::pcre8::PCRE(find, true) : nullptr;
+    auto terms   = (fregex == FRegex::NO && fterms == FTerms::YES) ? new MultiSearch(MultiSearch::Split(find), fcase == FCaseCompare::YES) : nullptr;
+    _buf1->find_lines("", find, rx, terms, fscope, ftrim, results);
+    _output->swap(results);
+    if (_output->size() > 0) {
         show_output(FOutput::SHOW);
-        statusbar_set_message(gnu::str::format(info::FOUND_LINES.c_str(), static_cast<unsigned>(lines.size()), gnu::Time::Milli() - time));
+        statusbar_set_message(gnu::str::format(info::FOUND_LINES.c_str(), static_cast<unsigned>(_output->size()), gnu::Time::Milli() - time));
     }
     else {
-        _regex->clear();
         statusbar_set_message(gnu::str::format(info::NO_STRING_FOUND.c_str(), find.c_str()));
     }
     take_focus();
     delete rx;
-    return lines.size();
-}
-size_t Editor::find_lines(const std::string& find, FRegex fregex, FTrim ftrim, std::vector<std::string>& out) {
-    auto size = out.size();
-    auto rx   = (fregex == FRegex::YES) ? new gnu::pcre8::PCRE(find, true) : (gnu::pcre8::PCRE*) nullptr;
-    _buf1->find_lines(_file_info.fi.name(), find, rx, ftrim, out);
+    delete terms;
+    return _output->size();
+}
+size_t Editor::find_lines(const std::string& find, FRegex fregex, FTerms fterms, FCaseCompare fcase, FScope fscope, FTrim ftrim, ResultStore& out) {
+    auto size  = out.size();
+    auto rx    = (fregex == FRegex::YES) ? new gnu::pcre8::PCRE(find, true) : (gnu::pcre8::PCRE*) nullptr;
+    auto terms = (fregex == FRegex::NO && fterms == FTerms::YES) ? new MultiSearch(MultiSearch::Split(find), fcase == FCaseCompare::YES) : (MultiSearch*) nullptr;
+    _buf1->find_lines(_file_info.fi.name(), find, rx, terms, fscope, ftrim, out);
     delete rx;
+    delete terms;
     return out.size() - size;
 }
+void Editor::find_incremental() {
+    auto& fr   = _findbar->findreplace();
+    auto  find = fr.find_string();
+    Fl::remove_timeout(Editor::CallbackIncremental, this);
+    _isearch.cancel();
+    if (find == "" || fr.fselection() == FSelection::YES || fr.fwordcompare() == FWordCompare::YES) {
+        _matches.clear();
+        redraw();
+        return;
+    }
+    else if (_isearch.has_snapshot() == false) {
+        _isearch.snapshot(_buf1->length(), cursor_insert_position(), _buf1->line_start(cursor_insert_position()));
+    }
+    if (_isearch.copy(*_buf1, IncrementalSearch::COPY) == false) {
+        _isearch.invalidate();
+        return;
+    }
+    if (fr.fregex() == FRegex::NO && (fr.fnltab() == FNlTab::YES || fr.fnltab() == FNlTab::FIND)) {
+        find = string::fnltab(find);
+    }
+    if (_isearch.start(find, fr.fcasecompare() == FCaseCompare::YES, fr.fregex() == FRegex::YES) == false) {
+        if (_isearch.err() != "") {
+            statusbar_set_message(_isearch.err());
+        }
+        return;
+    }
+    Fl::add_timeout(0.02, Editor::CallbackIncremental, this);
+}
 void Editor::find_quick() {
     auto start    = 0;
     auto end      = 0;
@@ -24604,7 +28527,7 @@ void Editor::find_quick() {
         selected = gnu::str::grab(_buf1->text_range(start, end));
         _findbar->findreplace().find_string(selected);
         _findbar->findreplace().add_find_word(selected);
-        CursorPos pos = _buf1->find_replace(selected, nullptr, FSearchDir::FORWARD, FCaseCompare::YES, FWordCompare::NO, FNlTab::NO);
+        CursorPos pos = _buf1->find_replace(selected, nullptr, FSearchDir::FORWARD, FCaseCompare::YES, FWordCompare::NO, FNlTab::NO, FScope::ALL);
         if (old != pos && pos.has_cursor() == true) {
             auto line = 0;
             auto col  = 0;
@@ -24645,7 +28568,8 @@ bool Editor::find_replace(FSearchDir fsearchdir, bool replace_text) {
         pos = _buf1->find_replace_regex(
             find,
             (replace_text == true) ? fr.replace_string().c_str() : nullptr,
-            fr.fnltab()
+            fr.fnltab(),
+            fr.fscope()
         );
     }
     else {
@@ -24655,7 +28579,8 @@ bool Editor::find_replace(FSearchDir fsearchdir, bool replace_text) {
             fsearchdir,
             fr.fcasecompare(),
             fr.fwordcompare(),
-            fr.fnltab()
+            fr.fnltab(),
+            fr.fscope()
         );
     }
     if (pos.has_cursor() == false) {
@@ -24688,24 +28613,33 @@ bool Editor::find_replace(FSearchDir fsearchdir, bool replace_text) {
     _findbar->findreplace().add_replace_word((replace_text == true) ? fr.replace_string() : "");
     return true;
 }
-size_t Editor::find_replace_all(std::string find, std::string replace, FNlTab fnltab, FSelection fselection, FCaseCompare fcase, FWordCompare fword, FRegex fregex, FSaveWord fsave, FHideFind fhide, bool disable_message) {
+size_t Editor::find_replace_all(std::string find, std::string replace, FNlTab fnltab, FSelection fselection, FCaseCompare fcase, FWordCompare fword, FRegex fregex, FScope fscope, FSaveWord fsave, FHideFind fhide, bool disable_message) {
     FLE_EDITOR_RETURN_IF_READONLY_1(0)
     auto time = gnu::Time::Milli();
     auto pos  = CursorPos();
-    if (fregex == FRegex::YES) {
+    if (_buf1->has_scope_style(fscope) == false) {
+        fl_beep(FL_BEEP_ERROR);
+        statusbar_set_message(info::NOT_STYLED);
+        return 0;
+    }
+    else if (fregex == FRegex::YES) {
         auto rx = gnu::pcre8::PCRE(find, true);
         if (rx.is_compiled() == false) {
             fl_beep(FL_BEEP_ERROR);
             statusbar_set_message(rx.err());
             return false;
         }
-        pos = _buf1->find_replace_regex_all(&rx, replace, fselection, fnltab);
+        pos = _buf1->find_replace_regex_all(&rx, replace, fselection, fnltab, fscope);
     }
     else {
-        pos = _buf1->find_replace_all(find, replace, fselection, fcase, fword, fnltab);
+        pos = _buf1->find_replace_all(find, replace, fselection, fcase, fword, fnltab, fscope);
     }
     cursor_move(pos);
-    if (_buf1->count_changes() == 0) {
+    if (_buf1->cancelled() == true) {
+        statusbar_set_message(info::CANCELLED);
+        take_focus();
+    }
+    else if (_buf1->count_changes() == 0) {
         if (disable_message == false) {
             statusbar_set_message(gnu::str::format(info::NO_STRINGS_REPLACED.c_str(), find.c_str(), replace.c_str()));
         }
@@ -24728,6 +28662,17 @@ size_t Editor::find_replace_all(std::string find, std::string replace, FNlTab fn
     }
     return _buf1->count_changes();
 }
+size_t Editor::find_replace_commit(const std::string& text, size_t count) {
+    FLE_EDITOR_RETURN_IF_READONLY_1(0)
+    auto time = gnu::Time::Milli();
+    auto pos  = _buf1->swap_text(text);
+    if (pos.has_cursor() == false) {
+        return 0;
+    }
+    cursor_move(pos);
+    statusbar_set_message(gnu::str::format(info::REPLACED_STRINGS.c_str(), (unsigned) count, gnu::Time::Milli() - time));
+    return count;
+}
 void Editor::goto_callback() {
     auto line = _goto->line();
     _goto->hide();
@@ -24784,10 +28729,17 @@ bool Editor::home() {
     _buf1->unselect();
     return true;
 }
-size_t Editor::memory_usage(size_t& buffer, size_t& style, size_t& undo) const {
-    buffer = _buf1->length();
-    style  = _buf2->length();
-    undo   = (_buf1->undo() != nullptr) ? _buf1->undo()->capacity() : 0;
+void Editor::matches_pause(bool pause) {
+    if (_matches.pause(pause) == true) {
+        _matches.rebuild(*_buf1);
+        redraw();
+    }
+}
+size_t Editor::memory_usage(size_t& buffer, size_t& style, size_t& undo, size_t& undo_raw) const {
+    buffer   = _buf1->length();
+    style    = _buf2->length();
+    undo     = (_buf1->undo() != nullptr) ? _buf1->undo()->capacity() : 0;
+    undo_raw = (_buf1->undo() != nullptr) ? _buf1->undo()->raw_capacity() : 0;
     return buffer + style + undo;
 }
 Message::CTRL Editor::message(const std::string& message, const std::string& s1, const std::string&, void*) {
@@ -24901,7 +28853,7 @@ size_t Editor::show_find_lines_dialog_or_run_again(FFindLines ffindlines) {
         find = FindDialog("Find Lines", list).run();
     }
     if (find != "") {
-        count = find_lines(find, FindDialog::REGEX, FindDialog::TRIM);
+        count = find_lines(find, FindDialog::REGEX, FindDialog::TERMS, FindDialog::CASE, FindDialog::SCOPE, FindDialog::TRIM);
         if (count > 0) {
             _findbar->findreplace().add_find_word(find);
         }
@@ -24992,9 +28944,7 @@ void Editor::style(Style* style) {
         statusbar_set_message(info::STYLE_OFF);
     }
     _style = (style == nullptr) ? new Style() : style;
-    for (const auto& w : _style->words()) {
-        _words.insert(w);
-    }
+    _words.insert(_style->words());
     _editor_flags.tab_mode  = _config.tab_mode(_style->name());
     _editor_flags.tab_width = _config.tab_width(_style->name());
     style_resize_buffer();
@@ -25074,9 +29024,9 @@ void Editor::text_move_lines(FMoveV move) {
 int Editor::text_remove_trailing() {
     FLE_EDITOR_RETURN_IF_READONLY_1(0)
     auto rx  = gnu::pcre8::PCRE("(\\s+)$");
-    auto pos = _buf1->find_replace_regex_all(&rx, "", FSelection::NO, FNlTab::NO);
+    auto pos = _buf1->find_replace_regex_all(&rx, "", FSelection::NO, FNlTab::NO, FScope::ALL);
     cursor_move(pos);
-    statusbar_set_message(gnu::str::format(info::REMOVED_TRAILING.c_str(), (unsigned) _buf1->count_changes()));
+    statusbar_set_message((_buf1->cancelled() == true) ? info::CANCELLED : gnu::str::format(info::REMOVED_TRAILING.c_str(), (unsigned) _buf1->count_changes()));
     return _buf1->count_changes();
 }
 void Editor::text_select_line() {
@@ -25131,8 +29081,11 @@ void Editor::text_sort_lines(FSort order) {
 }
 void Editor::text_to_space() {
     FLE_EDITOR_RETURN_IF_READONLY_0()
-    auto count = find_replace_all("\t", strings::SOFT_TABS[text_tab_width()], FNlTab::NO, FSelection::NO, FCaseCompare::NO, FWordCompare::NO, FRegex::NO, FSaveWord::NO, FHideFind::NO, true);
-    if (count == 0) {
+    auto count = find_replace_all("\t", strings::SOFT_TABS[text_tab_width()], FNlTab::NO, FSelection::NO, FCaseCompare::NO, FWordCompare::NO, FRegex::NO, FScope::ALL, FSaveWord::NO, FHideFind::NO, true);
+    if (_buf1->cancelled() == true) {
+        return;
+    }
+    else if (count == 0) {
         statusbar_set_message(info::NO_TABS_REPLACED);
     }
     else {
@@ -25141,8 +29094,11 @@ void Editor::text_to_space() {
 }
 void Editor::text_to_tab() {
     FLE_EDITOR_RETURN_IF_READONLY_0()
-    auto count = find_replace_all(strings::SOFT_TABS[text_tab_width()], "\t", FNlTab::NO, FSelection::NO, FCaseCompare::NO, FWordCompare::NO, FRegex::NO, FSaveWord::NO, FHideFind::NO, true);
-    if (count == 0) {
+    auto count = find_replace_all(strings::SOFT_TABS[text_tab_width()], "\t", FNlTab::NO, FSelection::NO, FCaseCompare::NO, FWordCompare::NO, FRegex::NO, FScope::ALL, FSaveWord::NO, FHideFind::NO, true);
+    if (_buf1->cancelled() == true) {
+        return;
+    }
+    else if (count == 0) {
         statusbar_set_message(info::NO_SPACES_REPLACED);
     }
     else {
@@ -25190,19 +29146,17 @@ void Editor::update_after_focus() {
         update_statusbar();
     }
 }
-void Editor::update_autocomplete(const char* text) {
-    _words.clear();
-    if (_config.pref_autocomplete == false || _buf1->length() > static_cast<int>(limits::AUTOCOMPLETE_FILESIZE_VAL) || _file_info.binary == true) {
+void Editor::update_autocomplete() {
+    Fl::remove_timeout(Editor::CallbackWords, this);
+    if (_config.pref_autocomplete == false || _file_info.binary == true) {
+        _words.clear();
         return;
     }
-    char* tmp = nullptr;
-    if (text == nullptr) {
-        text = _buf1->text();
-        tmp  = const_cast<char*>(text);
-    }
-    _words = _style->words();
-    string::make_word_list(text, _words, _config.custom_words);
-    free(tmp);
+    _words.clear_fixed();
+    _words.insert(_style->words());
+    _words.insert(_config.custom_words);
+    _words.build(_buf1->text(), _buf1->length());
+    Fl::add_timeout(0.05, Editor::CallbackWords, this);
 }
 void Editor::update_pref() {
     labelsize(flw::PREF_FONTSIZE);
@@ -25210,8 +29164,7 @@ void Editor::update_pref() {
     _menu->labelsize(flw::PREF_FONTSIZE);
     _menu->textfont(flw::PREF_FONT);
     _menu->textsize(flw::PREF_FONTSIZE);
-    _output->textfont(flw::PREF_FIXED_FONT);
-    _output->textsize(flw::PREF_FONTSIZE);
+    _output->update_pref(flw::PREF_FIXED_FONT, flw::PREF_FONTSIZE);
     if (_config.active == this) {
         _findbar->statusbar().update_menus(this);
     }
@@ -25228,7 +29181,7 @@ void Editor::update_pref() {
     if (_config.pref_autocomplete == false) {
         _words.clear();
     }
-    else if (_words.size() == 0 && _config.pref_autocomplete == true) {
+    else if (_words.is_active() == false && _words.is_building() == false && _config.pref_autocomplete == true) {
         update_autocomplete();
     }
     _buf1->undo_set_mode_using_config();
@@ -25263,7 +29216,7 @@ void Editor::update_statusbar() {
     }
     _findbar->statusbar().label_cursor(label);
     _findbar->statusbar().label_cursor_mode((_view->insert_mode() == 0) ? "OVR" : "INS");
-    if (_buf1->undo() != nullptr && _buf1->undo()->capacity() > (int64_t) limits::UNDO_WARNING) {
+    if (_buf1->undo() != nullptr && _buf1->undo()->capacity() > (int64_t) ((dynamic_cast<undo::BlockStore*>(_buf1->undo()->store()) != nullptr) ? limits::UNDO_WARNING : limits::UNDO_MEMORY_VAL)) {
         statusbar_set_message(gnu::str::format(info::UNDO_MEMORY.c_str(), (long long int) _buf1->undo()->capacity()));
     }
     if ((size_t) text_length() > limits::STYLE_FILESIZE_VAL && _style->name() != style::TEXT) {
@@ -25507,7 +29460,9 @@ constexpr static const char* MENU_DEBUG                         = "&Debug/Debug"
 constexpr static const char* MENU_DEBUG_COMPARE                 = "&Debug/Compare Buffer with File";
 constexpr static const char* MENU_DEBUG_PGO                     = "&PGO";
 constexpr static const char* MENU_DEBUG_PGO_RUN                 = "&PGO/Run";
+constexpr static const char* MENU_DEBUG_PGO_SEARCH              = "&PGO/Search Benchmark";
 constexpr static const char* MENU_DEBUG_PGO_UNDO                = "&PGO/Undo";
+constexpr static const char* MENU_DEBUG_PGO_UNDO_BENCHMARK      = "&PGO/Undo Benchmark";
 constexpr static const char* MENU_DEBUG_SIZE                    = "&Debug/Debug Size";
 constexpr static const char* MENU_FILE_CLOSE                    = "&File/Close File";
 constexpr static const char* MENU_FILE_CLOSE_ALL                = "&File/Close All Files";
@@ -25526,6 +29481,7 @@ constexpr static const char* MENU_FILE_SAVE_AS                  = "&File/Save As
 constexpr static const char* MENU_FILE_TERMINATE                = "&File/Terminate";
 constexpr static const char* MENU_FIND                          = "F&ind/";
 constexpr static const char* MENU_FIND_LINES                    = "F&ind/Find Lines in All Files...";
+constexpr static const char* MENU_FIND_PROJECT                  = "F&ind/Find Lines in Project...";
 constexpr static const char* MENU_FIND_REPLACE                  = "F&ind/Replace in All Files...";
 constexpr static const char* MENU_FIND_SHOW                     = "F&ind/Show Find";
 constexpr static const char* MENU_FIND_TRAILING                 = "F&ind/Remove Trailing Whitespace in All Files";
@@ -25539,6 +29495,8 @@ constexpr static const char* MENU_PROJECT_DB_CLOSE              = "&Project/Clos
 constexpr static const char* MENU_PROJECT_DB_DEFRAG             = "&Project/Defrag Database";
 constexpr static const char* MENU_PROJECT_DB_OPEN               = "&Project/Open Database...";
 constexpr static const char* MENU_PROJECT_DIR                   = "&Project/Set Project Directory...";
+constexpr static const char* MENU_PROJECT_IGNORE                = "&Project/Set Find in Project Ignore List...";
+constexpr static const char* MENU_PROJECT_INDEX                 = "&Project/Use Trigram Index for Find in Project";
 constexpr static const char* MENU_PROJECT_LOAD                  = "&Project/Load Project...";
 constexpr static const char* MENU_PROJECT_RENAME                = "&Project/Rename Project...";
 constexpr static const char* MENU_PROJECT_SAVE                  = "&Project/Save Project";
@@ -25605,6 +29563,8 @@ static const bool           DONT_CLOSE_EDITOR                   = false;
 static const bool           OPEN_FILE_USING_REAL_NAME           = false;
 static const std::string    NS_PROJECTS                         = "projects";
 static const std::string    NS_SNIPPETS                         = "snippets";
+static const std::string    NS_UNDO                             = "undo";
+static const std::string    PROJECT_IGNORE                      = ".git;.hg;.svn;node_modules;obj;*.a;*.o;*.obj;*.so;*.dll;*.exe;*.lib;*.gz;*.zip;*.png;*.jpg;*.gif;*.ico";
 static std::string FLEDIT_ABOUT = R"(flEdit r9.1
 
 Copyright 2024 - 2025 gnuwimp@gmail.com.
@@ -25726,6 +29686,12 @@ Parse output from a lua interpreter:
 #include <FL/Fl_Sys_Menu_Bar.H>
 #include <FL/Fl_Terminal.H>
 #include <FL/fl_ask.H>
+#include <FL/filename.H>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
 #include <thread>
 enum class Split {
     SHOW_ONE = 1,
@@ -25745,17 +29711,36 @@ enum class Output {
 };
 struct Command;
 typedef std::vector<Command*> CommandVector;
+struct FindLinesJob {
+    std::string                 filename;
+    char*                       style;
+    char*                       text;
+    int                         length;
+    fle::ResultStore            lines;
+                                FindLinesJob(const std::string& filename, char* text, char* style, int length)
+                                    { this->filename = filename; this->text = text; this->style = style; this->length = length; }
+};
+struct ReplaceAllJob {
+    fle::Editor*                editor;
+    char*                       style;
+    char*                       text;
+    int                         count;
+    int                         length;
+    size_t                      revision;
+    std::string                 result;
+                                ReplaceAllJob(fle::Editor* editor, char* text, char* style, int length, size_t revision)
+                                    { this->editor = editor; this->text = text; this->style = style; this->length = length; this->revision = revision; count = 0; }
+};
 extern fle::Config CONFIG;
 extern int KLUDGE;
 struct Command {
     static Command*             CURRENT;
     static CommandVector        COMMANDS;
     static gnu::file::Buf       BUF;
+    static fle::ResultStore     RESULTS;
     static int                  SELECT_LINE;
-    static std::string          LINE_REGEX;
     static std::string          WORKDIR;
     static std::thread*         THREAD;
-    static std::vector<std::string> LINES;
     std::string                 name;
     std::string                 command;
     Output                      output;
@@ -25820,10 +29805,10 @@ private:
 class CommandOutput : public flw::TabsGroup {
 public:
     static const int            MAX_BUFFER_SIZE    = 10'000'000;
-    static const int            MAX_LIST_LINES     =    100'000;
     static const int            MAX_TERMINAL_LINES =     10'000;
                                 CommandOutput(fle::Config& config, fle::FindBar* findbar);
                                 ~CommandOutput();
+    void                        add_list_data(const fle::ResultStore& results);
     void                        clear_all()
                                     { clear_editor(); clear_list(); reset_terminal(true); }
     void                        clear_editor()
@@ -25834,18 +29819,16 @@ public:
     fle::Editor*                editor() const
                                     { return _editor; }
     void                        join();
-    flw::ScrollBrowser*         list()
+    fle::ResultList*            list()
                                     { return _list; }
     void                        list_next()
                                     { auto row = (_list->value() == 0) ? 1 : _list->value() + 1; _list->value((row > _list->size()) ? 1 : row); _list->do_callback(); }
     void                        list_prev()
                                     { auto row = (_list->value() == 0) ? _list->size() : _list->value() - 1; _list->value((row < 1) ? _list->size() : row); _list->do_callback(); }
-    gnu::pcre8::PCRE&           list_rx()
-                                    { return _list_rx; }
     void                        reset_terminal(bool force);
     void                        run_command(const std::string& workpath, const std::string& filename, const std::string& selection, bool repeat);
     void                        set_editor_data(const gnu::file::Buf& buf);
-    void                        set_list_data(const std::vector<std::string>& lines, std::string parser, int select);
+    void                        set_list_data(fle::ResultStore& results, int select);
     void                        set_terminal_data(const gnu::file::Buf& buf);
     void                        show_editor()
                                     { show(); value(_editor); }
@@ -25861,10 +29844,9 @@ public:
     static void                 ThreadFuncForTerminal(std::string cmd, std::string work, CommandOutput* self);
     static void                 ThreadFuncForTerminalStream(std::string cmd, std::string work, CommandOutput* self);
 private:
-    flw::ScrollBrowser*         _list;
+    fle::ResultList*            _list;
     Fl_Terminal*                _terminal;
     fle::Editor*                _editor;
-    gnu::pcre8::PCRE            _list_rx;
 };
 class DirBrowser : public Fl_Group {
 public:
@@ -25904,6 +29886,123 @@ private:
     std::string                 _name;
     bool                        _run;
 };
+class ProjectIndex {
+public:
+    static const size_t         BITS_PER_TRIGRAM = 8;
+    static const unsigned       HASHES           = 3;
+    static const size_t         MAX_BITS         = 1'048'576;
+    static const size_t         MIN_BITS         = 256;
+    static const int64_t        RACY             = 2;
+    static const char           VERSION          = '2';
+    struct Dir {
+        int64_t                 indexed;
+        int64_t                 mtime;
+        std::vector<std::string> dirs;
+        std::vector<std::string> files;
+    };
+    struct Entry {
+        bool                    binary;
+        int64_t                 indexed;
+        int64_t                 mtime;
+        int64_t                 size;
+        std::string             bits;
+    };
+    typedef std::vector<std::pair<std::string, Dir>> DirUpdates;
+    typedef std::vector<std::pair<std::string, Entry>> Updates;
+                                ProjectIndex(const ProjectIndex&) = delete;
+                                ProjectIndex(ProjectIndex&&) = delete;
+    ProjectIndex&               operator=(const ProjectIndex&) = delete;
+    ProjectIndex&               operator=(ProjectIndex&&) = delete;
+    explicit                    ProjectIndex(const std::string& path);
+    size_t                      count_files() const
+                                    { return _entries.size(); }
+    const Entry*                find(const std::string& relative) const;
+    const Dir*                  find_dir(const std::string& relative) const;
+    bool                        load(gnu::db2::DB& db);
+    const std::string&          path() const
+                                    { return _path; }
+    bool                        save(gnu::db2::DB& db);
+    void                        update(const Updates& updates, const DirUpdates& dirs, const std::vector<std::string>& seen, bool complete);
+    static bool                 IsCurrent(int64_t mtime, int64_t indexed)
+                                    { return mtime >= 0 && indexed - mtime >= ProjectIndex::RACY; }
+    static Entry                Make(const char* text, size_t size, int64_t mtime, bool binary, std::vector<uint64_t>& seen);
+    static bool                 MayContain(const Entry& entry, const std::vector<uint32_t>& trigrams);
+    static std::string          RequiredLiteral(const std::string& pattern);
+    static std::vector<uint32_t> Trigrams(const std::string& literal);
+private:
+    static inline size_t        Hash(uint32_t trigram, unsigned k, size_t bits)
+                                    { auto h = trigram * 0x9e37'79b9'7f4a'7c15ull; return ((h >> 32) + k * ((h & 0xffff'ffff) | 1)) & (bits - 1); }
+    std::map<std::string, Dir>  _dirs;
+    std::map<std::string, Entry> _entries;
+    std::set<std::string>       _changed;
+    std::set<std::string>       _removed;
+    std::string                 _ns;
+    std::string                 _path;
+};
+class ProjectFind {
+public:
+    static const size_t         BINARY_SAMPLE = 8'192;
+    static const int64_t        MAX_FILE_SIZE = 64'000'000;
+                                ProjectFind(const ProjectFind&) = delete;
+                                ProjectFind(ProjectFind&&) = delete;
+    ProjectFind&                operator=(const ProjectFind&) = delete;
+    ProjectFind&                operator=(ProjectFind&&) = delete;
+                                ProjectFind(const std::string& path, const std::string& find, fle::FRegex fregex, fle::FTerms fterms, fle::FCaseCompare fcase, fle::FTrim ftrim, const std::string& ignore, const ProjectIndex* index = nullptr);
+                                ~ProjectFind();
+    void                        cancel()
+                                    { _cancel = true; _cond.notify_all(); }
+    size_t                      count_files() const
+                                    { return _files; }
+    size_t                      count_lines() const
+                                    { return _found; }
+    size_t                      count_skipped() const
+                                    { return _skipped; }
+    const std::string&          err() const
+                                    { return _err; }
+    bool                        has_reached_limit() const
+                                    { return _limit; }
+    const ProjectIndex::DirUpdates& index_dirs() const
+                                    { return _dir_updates; }
+    const std::vector<std::string>& index_seen() const
+                                    { return _seen; }
+    const ProjectIndex::Updates& index_updates() const
+                                    { return _updates; }
+    bool                        is_cancelled() const
+                                    { return _cancel; }
+    bool                        is_running() const
+                                    { return _running > 0; }
+    bool                        start();
+    fle::ResultStore            take_lines();
+    static bool                 IsIgnored(const std::string& name, const std::string& relative, const std::vector<std::string>& ignore);
+private:
+    bool                        _may_contain(const ProjectIndex::Entry& entry) const;
+    bool                        _read_file(const gnu::file::File& file, std::string& buffer) const;
+    static void                 ThreadFunc(ProjectFind* self);
+    fle::FTrim                  _ftrim;
+    fle::MultiSearch*           _terms;
+    gnu::pcre8::PCRE*           _rx;
+    int                         _active;
+    std::atomic<bool>           _cancel;
+    std::atomic<bool>           _limit;
+    std::atomic<int>            _running;
+    std::atomic<size_t>         _files;
+    std::atomic<size_t>         _found;
+    std::atomic<size_t>         _skipped;
+    const ProjectIndex*         _index;
+    ProjectIndex::DirUpdates    _dir_updates;
+    ProjectIndex::Updates       _updates;
+    fle::ResultStore            _lines;
+    std::condition_variable     _cond;
+    std::mutex                  _mutex;
+    std::string                 _err;
+    std::string                 _find;
+    std::string                 _path;
+    std::vector<std::string>    _dirs;
+    std::vector<std::string>    _ignore;
+    std::vector<std::string>    _seen;
+    std::vector<std::thread>    _threads;
+    std::vector<std::vector<uint32_t>> _trigrams;
+};
 class TextDialog : public Fl_Double_Window {
 public:
                                 TextDialog(gnu::db2::DB& db);
@@ -25991,9 +30090,14 @@ public:
     bool                        project_close_db();
     void                        project_defrag_db();
     bool                        project_exist_in_db(const std::string& project_name);
+    void                        project_find_ignore();
+    void                        project_find_index();
+    void                        project_find_lines();
+    void                        project_find_stop();
     void                        project_load_from_db(const std::string& project_name);
     std::vector<std::string>    project_load_list_from_pile(const std::string& key, gnu::pile::Pile& data);
     void                        project_load_snippet_from_db();
+    bool                        project_load_undo_from_db(fle::Editor* editor);
     void                        project_open_db();
     void                        project_path();
     void                        project_save_as_to_db(bool rename);
@@ -26002,6 +30106,7 @@ public:
     bool                        project_save_to_db()
                                     { return project_save_to_db(_project.name); }
     bool                        project_save_to_db(const std::string& name, const std::string& old_name = "");
+    bool                        project_save_undo_to_db(fle::Editor* editor);
     void                        project_wordlist();
     bool                        quit();
     fle::Message::CTRL          message(const std::string& message, const std::string& s1, const std::string& s2, void* p) override;
@@ -26065,8 +30170,11 @@ public:
     void                        tabs_move_all(bool to_left);
     void                        tabs_move(fle::Editor* editor);
     void                        tabs_pgo();
+    void                        tabs_pgo_search();
     void                        tabs_pgo_undo();
+    void                        tabs_pgo_undo_benchmark();
     void                        tabs_replace_all();
+    void                        tabs_replace_all_in_selection(const std::string& find, const std::string& replace);
     void                        tabs_reset_split_size();
     void                        tabs_restore_visibility();
     bool                        tabs_save_all(bool ask);
@@ -26091,10 +30199,15 @@ public:
                                     { if (_tabs.tabs2->visible()) split_view(Split::HIDE_TWO); else split_view(Split::SHOW_TWO); }
     void                        update_menu();
     void                        update_pref();
+    static int                  Benchmark(int argc, const char** argv);
     static void                 CallbackFileBrowser(Fl_Widget* sender, void* data);
     static void                 CallbackList(Fl_Widget* sender, void* data);
+    static void                 CallbackProjectFind(void* data);
     static void                 CallbackRecent(Fl_Widget* sender, void* data);
     static void                 CallbackWindow(Fl_Widget* sender, void* data);
+    static void                 ThreadFuncForFindLines(std::vector<FindLinesJob>* jobs, std::atomic<size_t>* next, std::atomic<size_t>* done, std::atomic<bool>* cancel, std::string find, const gnu::pcre8::PCRE* rx, const fle::MultiSearch* terms, fle::FScope fscope, fle::FTrim ftrim);
+    static void                 ThreadFuncForReplaceAll(std::vector<ReplaceAllJob>* jobs, std::atomic<size_t>* next, std::atomic<size_t>* done, std::atomic<bool>* cancel, std::string find, std::string replace);
+    static int                  UndoEditors(const std::vector<fle::Editor*>& editors);
     static inline void          CheckExternalUpdate()
                                     { SELF->tabs_check_external_update(); }
     static inline void          ShowOutputEditor()
@@ -26122,7 +30235,8 @@ private:
     flw::SplitGroup*            _split_edit;
     flw::SplitGroup*            _split_main;
     gnu::db2::DB                _db;
-    gnu::pcre8::PCRE            _list_rx;
+    ProjectFind*                _project_find;
+    ProjectIndex*               _project_index;
     std::string                 _search;
     std::string                 _search_all;
     std::vector<std::string>    _old_find_list;
@@ -26143,6 +30257,8 @@ private:
         std::string             path;
         std::string             name;
         std::string             wordfile;
+        std::string             ignore;
+        bool                    index;
     }                           _project;
     struct {
         std::string             start_path;
@@ -26623,13 +30739,12 @@ int                         Command::SELECT_LINE    = 0;
 std::thread*                Command::THREAD         = nullptr;
 CommandVector               Command::COMMANDS;
 gnu::file::Buf              Command::BUF;
-std::string                 Command::LINE_REGEX;
+fle::ResultStore            Command::RESULTS;
 std::string                 Command::WORKDIR;
-std::vector<std::string>    Command::LINES;
 CommandOutput::CommandOutput(fle::Config& config, fle::FindBar* findbar) : flw::TabsGroup(0, 0, 0, 0) {
     end();
     _editor   = new fle::Editor(config, findbar);
-    _list     = new flw::ScrollBrowser();
+    _list     = new fle::ResultList();
     _terminal = new Fl_Terminal(0, 0, 0, 0);
     add("List", _list);
     add("Editor", _editor);
@@ -26725,9 +30840,8 @@ void CommandOutput::create_command_thread(std::string workpath, std::string file
             delete rx;
         }
         else {
-            _list_rx.clear();
             _list->clear();
-            _list->add(gnu::str::format("executing %s", cmd.c_str()).c_str());
+            _list->add(gnu::str::format("executing %s", cmd.c_str()));
             _list->deactivate();
             FlEdit::ShowOutputList();
             Command::THREAD = new std::thread(CommandOutput::ThreadFuncForList, cmd, work, rx, Command::CURRENT->line_regex, this);
@@ -26761,7 +30875,7 @@ void CommandOutput::join() {
         show_main_editor();
     }
     else if (Command::CURRENT->output == Output::CAPTURE_LIST) {
-        set_list_data(Command::LINES, Command::LINE_REGEX, Command::SELECT_LINE);
+        set_list_data(Command::RESULTS, Command::SELECT_LINE);
         show_main_editor();
     }
     else if (Command::CURRENT->output == Output::CAPTURE_TERMINAL) {
@@ -26770,8 +30884,7 @@ void CommandOutput::join() {
     else if (Command::CURRENT->output == Output::STREAM_TERMINAL) {
         show_main_editor();
     }
-    Command::LINES.clear();
-    Command::LINE_REGEX = "";
+    Command::RESULTS.clear();
     Command::SELECT_LINE = 0;
     Command::BUF.clear();
     FlEdit::CheckExternalUpdate();
@@ -26813,21 +30926,12 @@ void CommandOutput::set_editor_data(const gnu::file::Buf& buf) {
     _editor->text_set(buf.c_str(), fle::FLineEnding::UNIX, fle::FChecksum::NO);
     value(_editor);
 }
-void CommandOutput::set_list_data(const std::vector<std::string>& lines, std::string parser, int select) {
-    _list->clear();
+void CommandOutput::add_list_data(const fle::ResultStore& results) {
+    _list->append(results);
+}
+void CommandOutput::set_list_data(fle::ResultStore& results, int select) {
+    _list->swap(results);
     _list->activate();
-    for (const auto& line : lines) {
-        if (line.length() > fle::limits::OUTPUT_LINE_LENGTH_VAL) {
-            auto l = line;
-            l.resize(fle::limits::OUTPUT_LINE_LENGTH_VAL);
-            l += "|";
-            _list->add(l.c_str());
-        }
-        else {
-            _list->add(line.c_str());
-        }
-    }
-    _list_rx.compile(parser);
     if (select > 0) {
         _list->value(select);
     }
@@ -26883,14 +30987,13 @@ void CommandOutput::ThreadFuncForList(const std::string cmd, const std::string w
     gnu::file::chdir(work);
     Command::WORKDIR = gnu::file::work_dir().filename();
     Command::SELECT_LINE = 0;
-    Command::LINE_REGEX = line_regex;
     Command::BUF.clear();
-    Command::LINES.clear();
-    Command::LINES.push_back(gnu::str::format("running in directory %s", Command::WORKDIR.c_str()));
-    Command::LINES.push_back(gnu::str::format("executing %s", cmd.c_str()));
+    Command::RESULTS.clear();
+    Command::RESULTS.add(gnu::str::format("running in directory %s", Command::WORKDIR.c_str()));
+    Command::RESULTS.add(gnu::str::format("executing %s", cmd.c_str()));
     handle = gnu::file::popen(cmd);
     if (handle == nullptr) {
-        Command::LINES.push_back("error: failed to execute command");
+        Command::RESULTS.add("error: failed to execute command");
     }
     else {
         while (true) {
@@ -26903,27 +31006,42 @@ void CommandOutput::ThreadFuncForList(const std::string cmd, const std::string w
                 break;
             }
             else if (Command::BUF.size() >= CommandOutput::MAX_BUFFER_SIZE) {
-                Command::LINES.push_back("error: max read bytes limits has been reached!");
+                Command::RESULTS.add("error: max read bytes limits has been reached!");
                 break;
             }
         }
         pclose(handle);
-        Command::BUF.add("\0", 1);
-        Command::LINES.push_back("Output:");
-        Command::SELECT_LINE = (int) Command::LINES.size();
-        for (const auto& line : gnu::str::split(Command::BUF.c_str(), "\n")) {
-            if (filter_regex->is_compiled() == false || filter_regex->exec(line).size() > 0) {
-                if (Command::LINES.size() == CommandOutput::MAX_LIST_LINES) {
-                    Command::LINES.push_back("error: line limits have been reached!");
-                    break;
-                }
-                else {
-                    auto tmp = gnu::str::replace_const(line, "\r");
-                    Command::LINES.push_back(tmp);
-                }
+        auto rx = gnu::pcre8::PCRE(line_regex);
+        if (line_regex != "" && rx.is_compiled() == false) {
+            Command::RESULTS.add(gnu::str::format("error: line regex <%s> is invalid, %s", line_regex.c_str(), rx.err().c_str()));
+        }
+        Command::RESULTS.add("Output:");
+        Command::SELECT_LINE = (int) Command::RESULTS.size();
+        rx.set_names({"file", "line", "col"});
+        auto off  = std::vector<int>();
+        auto text = Command::BUF.c_str();
+        auto len  = Command::BUF.size();
+        auto pos  = (size_t) 0;
+        while (pos < len) {
+            auto end  = static_cast<const char*>(memchr(text + pos, '\n', len - pos));
+            auto stop = (end == nullptr) ? len : static_cast<size_t>(end - text);
+            auto line = gnu::str::replace_const(std::string(text + pos, stop - pos), "\r");
+            pos = stop + 1;
+            if (filter_regex->is_compiled() == true && filter_regex->exec_offsets(line.c_str(), line.length(), off) <= 0) {
+                continue;
+            }
+            else if (fle::limits::OUTPUT_LINES_VAL > 0 && Command::RESULTS.size() >= fle::limits::OUTPUT_LINES_VAL) {
+                Command::RESULTS.add("error: line limits have been reached!");
+                break;
+            }
+            else if (rx.is_compiled() == true && rx.exec(line).size() > 1 && rx.match("file").word() != "") {
+                Command::RESULTS.add_output(line, rx.match("file").word(), (int) gnu::str::to_int(rx.match("line").word(), 1), (int) gnu::str::to_int(rx.match("col").word(), 1));
+            }
+            else {
+                Command::RESULTS.add_output(line);
             }
         }
-        Command::LINES.push_back(std::string("Finished in ") + gnu::Time::FormatMilliToTime((gnu::Time::Milli() - start) / 1000));
+        Command::RESULTS.add(std::string("Finished in ") + gnu::Time::FormatMilliToTime((gnu::Time::Milli() - start) / 1000));
     }
     delete filter_regex;
     Fl::awake(CommandOutput::Join, self);
@@ -27008,8 +31126,7 @@ void CommandOutput::ThreadFuncForTerminalStream(const std::string cmd, const std
 void CommandOutput::update_pref() {
     TabsGroup::update_pref();
     _editor->update_pref();
-    _list->textfont(flw::PREF_FIXED_FONT);
-    _list->textsize(flw::PREF_FIXED_FONTSIZE);
+    _list->update_pref(flw::PREF_FIXED_FONT, flw::PREF_FIXED_FONTSIZE);
     _terminal->textfont(flw::PREF_FIXED_FONT);
     _terminal->textsize(flw::PREF_FIXED_FONTSIZE);
 }
@@ -27129,49 +31246,537 @@ void ProjectDialog::Callback(Fl_Widget* w, void* o) {
         self->_run = false;
         self->hide();
     }
-    else if (w == self->_load) {
-        self->_name = gnu::str::to_string(self->_projects->text(self->_projects->value()));
-        if (self->_name != "") {
-            self->_run = false;
-            self->hide();
+    else if (w == self->_load) {
+        self->_name = gnu::str::to_string(self->_projects->text(self->_projects->value()));
+        if (self->_name != "") {
+            self->_run = false;
+            self->hide();
+        }
+        else {
+            fl_beep(FL_BEEP_NOTIFICATION);
+        }
+    }
+    else if (w == self->_remove) {
+        auto row = self->_projects->value();
+        if (row > 0) {
+            auto name = gnu::str::to_string(self->_projects->text(row));
+            if (self->_db.remove(NS_PROJECTS, name) == false) {
+                flw::dlg::msg_alert("flEdit", flw::util::format("Failed to delete project from database!\n%s", self->_db.err_msg.c_str()));
+                return;
+            }
+            self->_projects->remove(row);
+        }
+    }
+    else if (w == self->_projects) {
+        auto row = self->_projects->value();
+        if (row > 0) {
+            self->_load->activate();
+            self->_remove->activate();
+        }
+        if (row > 0 && Fl::event_clicks() > 0) {
+            Fl::event_clicks(0);
+            Callback(self->_load, self);
+        }
+    }
+}
+std::string ProjectDialog::run(Fl_Window* parent) {
+    _run = true;
+    _projects->take_focus();
+    flw::util::center_window(this, parent);
+    show();
+    while (_run == true) {
+        Fl::wait();
+        Fl::flush();
+    }
+    return _name;
+}
+ProjectFind::ProjectFind(const std::string& path, const std::string& find, fle::FRegex fregex, fle::FTerms fterms, fle::FCaseCompare fcase, fle::FTrim ftrim, const std::string& ignore, const ProjectIndex* index) {
+    _active   = 0;
+    _cancel   = false;
+    _files    = 0;
+    _find     = find;
+    _found    = 0;
+    _ftrim    = ftrim;
+    _index    = index;
+    _limit    = false;
+    _path     = gnu::file::File(path).filename();
+    _running  = 0;
+    _rx       = (fregex == fle::FRegex::YES) ? new gnu::pcre8::PCRE(find, true) : nullptr;
+    _skipped  = 0;
+    _terms    = (fregex == fle::FRegex::NO && fterms == fle::FTerms::YES) ? new fle::MultiSearch(fle::MultiSearch::Split(find), fcase == fle::FCaseCompare::YES) : nullptr;
+    if (_terms != nullptr) {
+        for (const auto& term : _terms->terms()) {
+            _trigrams.push_back(ProjectIndex::Trigrams(term));
+        }
+    }
+    else {
+        _trigrams.push_back(ProjectIndex::Trigrams((fregex == fle::FRegex::YES) ? ProjectIndex::RequiredLiteral(find) : find));
+    }
+    for (const auto& glob : gnu::str::split(ignore, ";")) {
+        auto g = glob;
+        gnu::str::trim(g);
+        if (g != "") {
+            _ignore.push_back(g);
+        }
+    }
+}
+ProjectFind::~ProjectFind() {
+    cancel();
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+    delete _rx;
+    delete _terms;
+}
+bool ProjectFind::IsIgnored(const std::string& name, const std::string& relative, const std::vector<std::string>& ignore) {
+    for (const auto& glob : ignore) {
+        if (glob.find('/') != std::string::npos) {
+            if (fl_filename_match(relative.c_str(), glob.c_str()) != 0) {
+                return true;
+            }
+        }
+        else if (fl_filename_match(name.c_str(), glob.c_str()) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+bool ProjectFind::_may_contain(const ProjectIndex::Entry& entry) const {
+    for (const auto& trigrams : _trigrams) {
+        if (ProjectIndex::MayContain(entry, trigrams) == true) {
+            return true;
+        }
+    }
+    return false;
+}
+bool ProjectFind::_read_file(const gnu::file::File& file, std::string& buffer) const {
+    auto handle = gnu::file::open(file.filename(), "rb");
+    if (handle == nullptr) {
+        return false;
+    }
+    auto size   = static_cast<size_t>(file.size());
+    auto sample = std::min(size, ProjectFind::BINARY_SAMPLE);
+    buffer.resize(size);
+    auto read = fread(buffer.data(), 1, sample, handle);
+    auto res  = memchr(buffer.data(), 0, read) == nullptr;
+    if (res == true && read < size) {
+        read += fread(buffer.data() + read, 1, size - read, handle);
+    }
+    buffer.resize(read);
+    fclose(handle);
+    return res;
+}
+bool ProjectFind::start() {
+    if (_rx != nullptr && _rx->is_compiled() == false) {
+        _err = _rx->err();
+        return false;
+    }
+    else if (gnu::file::File(_path).is_dir() == false) {
+        _err = gnu::str::format("Error: %s is not a directory!", _path.c_str());
+        return false;
+    }
+    auto count = std::max(std::thread::hardware_concurrency(), 1u);
+    _dirs.push_back(_path);
+    _running = count;
+    for (unsigned f = 0; f < count; f++) {
+        _threads.push_back(std::thread(ProjectFind::ThreadFunc, this));
+    }
+    return true;
+}
+fle::ResultStore ProjectFind::take_lines() {
+    auto lock = std::unique_lock<std::mutex>(_mutex);
+    auto res  = fle::ResultStore();
+    res.swap(_lines);
+    return res;
+}
+void ProjectFind::ThreadFunc(ProjectFind* self) {
+    auto buffer   = std::string();
+    auto lines    = fle::ResultStore();
+    auto dirs     = std::vector<std::string>();
+    auto listings = ProjectIndex::DirUpdates();
+    auto seen     = std::vector<std::string>();
+    auto trigrams = std::vector<uint64_t>();
+    auto updates  = ProjectIndex::Updates();
+    while (true) {
+        auto dir = std::string();
+        {
+            auto lock = std::unique_lock<std::mutex>(self->_mutex);
+            self->_cond.wait(lock, [self] { return self->_dirs.size() > 0 || self->_active == 0 || self->_cancel == true; });
+            if (self->_dirs.size() == 0 || self->_cancel == true) {
+                break;
+            }
+            dir = self->_dirs.back();
+            self->_dirs.pop_back();
+            self->_active++;
+        }
+        auto prefix  = (dir.length() > self->_path.length()) ? dir.substr(self->_path.length() + 1) + "/" : std::string();
+        auto mtime   = gnu::file::File(dir).mtime();
+        auto listing = (self->_index != nullptr) ? self->_index->find_dir("/" + prefix) : nullptr;
+        auto files   = gnu::file::Files();
+        auto subdir  = [&](const std::string& name) {
+            if (ProjectFind::IsIgnored(name, prefix + name, self->_ignore) == false) {
+                dirs.push_back(dir + "/" + name);
+            }
+        };
+        if (listing != nullptr && listing->mtime == mtime && ProjectIndex::IsCurrent(listing->mtime, listing->indexed) == true) {
+            for (const auto& name : listing->dirs) {
+                subdir(name);
+            }
+            for (const auto& name : listing->files) {
+                files.push_back(gnu::file::File(dir + "/" + name));
+            }
+        }
+        else {
+            auto update = ProjectIndex::Dir{static_cast<int64_t>(::time(nullptr)), mtime, {}, {}};
+            for (const auto& file : gnu::file::read_dir(dir)) {
+                if (file.is_link() == false && file.is_dir() == true) {
+                    update.dirs.push_back(file.name());
+                    subdir(file.name());
+                }
+                else if (file.is_link() == false && file.is_file() == true) {
+                    update.files.push_back(file.name());
+                    files.push_back(file);
+                }
+            }
+            if (self->_index != nullptr) {
+                listings.push_back(std::make_pair("/" + prefix, std::move(update)));
+            }
+        }
+        if (self->_index != nullptr) {
+            seen.push_back("/" + prefix);
+        }
+        for (const auto& file : files) {
+            auto relative = file.filename().substr(std::min(self->_path.length() + 1, file.filename().length()));
+            if (self->_cancel == true) {
+                break;
+            }
+            else if (file.is_link() == false && file.is_file() == true && file.size() <= ProjectFind::MAX_FILE_SIZE && ProjectFind::IsIgnored(file.name(), relative, self->_ignore) == false) {
+                auto entry = (self->_index != nullptr) ? self->_index->find(relative) : nullptr;
+                auto text  = false;
+                if (self->_index != nullptr) {
+                    seen.push_back(relative);
+                }
+                if (entry != nullptr && entry->mtime == file.mtime() && entry->size == file.size() && ProjectIndex::IsCurrent(entry->mtime, entry->indexed) == true) {
+                    if (entry->binary == true || self->_may_contain(*entry) == false) {
+                        self->_skipped++;
+                        continue;
+                    }
+                    text = self->_read_file(file, buffer);
+                }
+                else {
+                    text = self->_read_file(file, buffer);
+                    if (self->_index != nullptr) {
+                        updates.push_back(std::make_pair(relative, ProjectIndex::Make(buffer.data(), buffer.length(), file.mtime(), text == false, trigrams)));
+                        updates.back().second.size = file.size();
+                    }
+                }
+                if (text == true) {
+                    self->_found += fle::TextBuffer::FindLines(relative, buffer.data(), static_cast<int>(buffer.length()), self->_find, self->_rx, self->_terms, nullptr, fle::FScope::ALL, self->_ftrim, lines, &self->_cancel);
+                    self->_files++;
+                    if (fle::limits::OUTPUT_LINES_VAL > 0 && self->_found >= fle::limits::OUTPUT_LINES_VAL) {
+                        self->_limit  = true;
+                        self->_cancel = true;
+                    }
+                }
+            }
+        }
+        {
+            auto lock = std::unique_lock<std::mutex>(self->_mutex);
+            self->_dirs.insert(self->_dirs.end(), dirs.rbegin(), dirs.rend());
+            self->_lines.append(lines);
+            self->_seen.insert(self->_seen.end(), seen.begin(), seen.end());
+            self->_dir_updates.insert(self->_dir_updates.end(), listings.begin(), listings.end());
+            self->_updates.insert(self->_updates.end(), updates.begin(), updates.end());
+            self->_active--;
+        }
+        self->_cond.notify_all();
+        dirs.clear();
+        lines.clear();
+        listings.clear();
+        seen.clear();
+        updates.clear();
+    }
+    self->_running--;
+    self->_cond.notify_all();
+}
+ProjectIndex::ProjectIndex(const std::string& path) {
+    _path = gnu::file::File(path).filename();
+    _ns   = "index:" + _path;
+}
+const ProjectIndex::Entry* ProjectIndex::find(const std::string& relative) const {
+    auto it = _entries.find(relative);
+    return (it != _entries.end()) ? &it->second : nullptr;
+}
+const ProjectIndex::Dir* ProjectIndex::find_dir(const std::string& relative) const {
+    auto it = _dirs.find(relative);
+    return (it != _dirs.end()) ? &it->second : nullptr;
+}
+bool ProjectIndex::load(gnu::db2::DB& db) {
+    if (db.is_open() == false) {
+        return false;
+    }
+    _dirs.clear();
+    _entries.clear();
+    _changed.clear();
+    _removed.clear();
+    for (const auto& row : db.get_rows(_ns)) {
+        if (row.key().c_str()[0] == '/' && row.size() >= 9 && row.c_str()[0] == 'D') {
+            auto dir   = Dir();
+            auto names = gnu::str::split(std::string(row.c_str() + 9, row.size() - 9), "\n");
+            dir.mtime = row.time();
+            memcpy(&dir.indexed, row.c_str() + 1, 8);
+            for (const auto& name : names) {
+                if (name.length() > 1 && name[0] == 'd') {
+                    dir.dirs.push_back(name.substr(1));
+                }
+                else if (name.length() > 1 && name[0] == 'f') {
+                    dir.files.push_back(name.substr(1));
+                }
+            }
+            _dirs[row.key()] = dir;
+        }
+        else if (row.key().c_str()[0] != '/' && row.size() >= 17 && (row.c_str()[0] == ProjectIndex::VERSION || row.c_str()[0] == ProjectIndex::VERSION + 1)) {
+            auto entry = Entry();
+            entry.binary = row.c_str()[0] == ProjectIndex::VERSION + 1;
+            entry.mtime  = row.time();
+            memcpy(&entry.size, row.c_str() + 1, 8);
+            memcpy(&entry.indexed, row.c_str() + 9, 8);
+            entry.bits.assign(row.c_str() + 17, row.size() - 17);
+            _entries[row.key()] = entry;
+        }
+        else {
+            _removed.insert(row.key());
+        }
+    }
+    return true;
+}
+ProjectIndex::Entry ProjectIndex::Make(const char* text, size_t size, int64_t mtime, bool binary, std::vector<uint64_t>& seen) {
+    auto res   = Entry();
+    auto bits  = ProjectIndex::MIN_BITS;
+    auto count = (size_t) 0;
+    res.binary  = binary;
+    res.indexed = static_cast<int64_t>(::time(nullptr));
+    res.mtime   = mtime;
+    res.size    = static_cast<int64_t>(size);
+    if (binary == true) {
+        return res;
+    }
+    seen.resize(0x100'0000 / 64);
+    auto trigram = 0u;
+    for (size_t f = 0; f < size; f++) {
+        trigram = ((trigram << 8) | fle::LiteralSearch::Lower(text[f])) & 0xffffff;
+        if (f >= 2 && (seen[trigram >> 6] & ((uint64_t) 1 << (trigram & 63))) == 0) {
+            seen[trigram >> 6] |= (uint64_t) 1 << (trigram & 63);
+            count++;
+        }
+    }
+    while (bits < ProjectIndex::MAX_BITS && bits < count * ProjectIndex::BITS_PER_TRIGRAM) {
+        bits *= 2;
+    }
+    res.bits.assign(bits / 8, 0);
+    auto data = reinterpret_cast<uint8_t*>(res.bits.data());
+    trigram = 0;
+    for (size_t f = 0; f < size; f++) {
+        trigram = ((trigram << 8) | fle::LiteralSearch::Lower(text[f])) & 0xffffff;
+        if (f >= 2 && (seen[trigram >> 6] & ((uint64_t) 1 << (trigram & 63))) != 0) {
+            seen[trigram >> 6] &= ~((uint64_t) 1 << (trigram & 63));
+            for (unsigned k = 0; k < ProjectIndex::HASHES; k++) {
+                auto bit = ProjectIndex::Hash(trigram, k, bits);
+                data[bit >> 3] |= 1 << (bit & 7);
+            }
+        }
+    }
+    return res;
+}
+bool ProjectIndex::MayContain(const Entry& entry, const std::vector<uint32_t>& trigrams) {
+    auto bits = entry.bits.length() * 8;
+    auto data = reinterpret_cast<const uint8_t*>(entry.bits.data());
+    if (bits == 0) {
+        return true;
+    }
+    for (auto trigram : trigrams) {
+        for (unsigned k = 0; k < ProjectIndex::HASHES; k++) {
+            auto bit = ProjectIndex::Hash(trigram, k, bits);
+            if ((data[bit >> 3] & (1 << (bit & 7))) == 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+std::string ProjectIndex::RequiredLiteral(const std::string& pattern) {
+    auto best  = std::string();
+    auto cur   = std::string();
+    auto depth = 0;
+    auto len   = pattern.length();
+    auto flush = [&]() {
+        if (cur.length() > best.length()) {
+            best = cur;
+        }
+        cur.clear();
+    };
+    for (size_t f = 0; f < len; f++) {
+        auto c = pattern[f];
+        if (c == '|') {
+            return "";
+        }
+        else if (c == '\\') {
+            auto n = (f + 1 < len) ? pattern[f + 1] : 0;
+            f++;
+            if (n == 0 || isdigit(n) != 0 || strchr("xcopPNkgQEu", n) != nullptr) {
+                return "";
+            }
+            else if (depth == 0 && ispunct(n) != 0) {
+                cur += n;
+            }
+            else {
+                flush();
+            }
+        }
+        else if (c == '[') {
+            flush();
+            f++;
+            if (f < len && pattern[f] == '^') {
+                f++;
+            }
+            if (f < len && pattern[f] == ']') {
+                f++;
+            }
+            while (f < len && pattern[f] != ']') {
+                f += (pattern[f] == '\\') ? 2 : 1;
+            }
+        }
+        else if (c == '(') {
+            flush();
+            depth++;
+            if (f + 1 < len && pattern[f + 1] == '?') {
+                if (f + 2 < len && (pattern[f + 2] == '!' || (pattern[f + 2] == '<' && f + 3 < len && pattern[f + 3] == '!'))) {
+                    return "";
+                }
+                for (auto g = f + 2; g < len && pattern[g] != ')' && pattern[g] != ':' && pattern[g] != '<' && pattern[g] != '\''; g++) {
+                    if (pattern[g] == 'x') {
+                        return "";
+                    }
+                }
+            }
+        }
+        else if (c == ')') {
+            flush();
+            depth--;
+        }
+        else if (c == '*' || c == '?' || c == '+' || c == '{') {
+            if (cur.length() > 0) {
+                cur.pop_back();
+            }
+            flush();
+            while (c == '{' && f < len && pattern[f] != '}') {
+                f++;
+            }
+        }
+        else if (c == '.' || c == '^' || c == '$' || depth > 0) {
+            flush();
+        }
+        else {
+            cur += c;
+        }
+    }
+    flush();
+    return best;
+}
+bool ProjectIndex::save(gnu::db2::DB& db) {
+    if (_changed.size() == 0 && _removed.size() == 0) {
+        return true;
+    }
+    else if (db.is_open() == false || db.begin() == false) {
+        return false;
+    }
+    auto value = std::string();
+    for (const auto& key : _changed) {
+        auto mtime = (int64_t) 0;
+        if (key.front() == '/') {
+            const auto& dir = _dirs[key];
+            mtime = dir.mtime;
+            value.assign(1, 'D');
+            value.append(reinterpret_cast<const char*>(&dir.indexed), 8);
+            for (const auto& name : dir.dirs) {
+                value += "d" + name + "\n";
+            }
+            for (const auto& name : dir.files) {
+                value += "f" + name + "\n";
+            }
         }
         else {
-            fl_beep(FL_BEEP_NOTIFICATION);
+            const auto& entry = _entries[key];
+            mtime = entry.mtime;
+            value.assign(1, static_cast<char>((entry.binary == true) ? ProjectIndex::VERSION + 1 : ProjectIndex::VERSION));
+            value.append(reinterpret_cast<const char*>(&entry.size), 8);
+            value.append(reinterpret_cast<const char*>(&entry.indexed), 8);
+            value.append(entry.bits);
+        }
+        if (db.put(_ns, key, value, mtime) == false) {
+            db.rollback();
+            return false;
         }
     }
-    else if (w == self->_remove) {
-        auto row = self->_projects->value();
-        if (row > 0) {
-            auto name = gnu::str::to_string(self->_projects->text(row));
-            if (self->_db.remove(NS_PROJECTS, name) == false) {
-                flw::dlg::msg_alert("flEdit", flw::util::format("Failed to delete project from database!\n%s", self->_db.err_msg.c_str()));
-                return;
-            }
-            self->_projects->remove(row);
+    for (const auto& key : _removed) {
+        db.remove(_ns, key);
+    }
+    if (db.commit() == false) {
+        db.rollback();
+        return false;
+    }
+    _changed.clear();
+    _removed.clear();
+    return true;
+}
+std::vector<uint32_t> ProjectIndex::Trigrams(const std::string& literal) {
+    auto res     = std::vector<uint32_t>();
+    auto trigram = 0u;
+    for (size_t f = 0; f < literal.length(); f++) {
+        trigram = ((trigram << 8) | fle::LiteralSearch::Lower(literal[f])) & 0xffffff;
+        if (f >= 2) {
+            res.push_back(trigram);
         }
     }
-    else if (w == self->_projects) {
-        auto row = self->_projects->value();
-        if (row > 0) {
-            self->_load->activate();
-            self->_remove->activate();
+    std::sort(res.begin(), res.end());
+    res.erase(std::unique(res.begin(), res.end()), res.end());
+    return res;
+}
+void ProjectIndex::update(const Updates& updates, const DirUpdates& dirs, const std::vector<std::string>& seen, bool complete) {
+    for (const auto& update : updates) {
+        _entries[update.first] = update.second;
+        _changed.insert(update.first);
+        _removed.erase(update.first);
+    }
+    for (const auto& update : dirs) {
+        _dirs[update.first] = update.second;
+        _changed.insert(update.first);
+        _removed.erase(update.first);
+    }
+    if (complete == false) {
+        return;
+    }
+    auto keep = std::set<std::string>(seen.begin(), seen.end());
+    for (auto it = _dirs.begin(); it != _dirs.end(); ) {
+        if (keep.count(it->first) == 0) {
+            _changed.erase(it->first);
+            _removed.insert(it->first);
+            it = _dirs.erase(it);
         }
-        if (row > 0 && Fl::event_clicks() > 0) {
-            Fl::event_clicks(0);
-            Callback(self->_load, self);
+        else {
+            ++it;
         }
     }
-}
-std::string ProjectDialog::run(Fl_Window* parent) {
-    _run = true;
-    _projects->take_focus();
-    flw::util::center_window(this, parent);
-    show();
-    while (_run == true) {
-        Fl::wait();
-        Fl::flush();
+    for (auto it = _entries.begin(); it != _entries.end(); ) {
+        if (keep.count(it->first) == 0) {
+            _changed.erase(it->first);
+            _removed.insert(it->first);
+            it = _entries.erase(it);
+        }
+        else {
+            ++it;
+        }
     }
-    return _name;
 }
 static int _TextDialog_LAST_SPLIT = 0;
 TextDialog::TextDialog(gnu::db2::DB& db) :
@@ -27409,7 +32014,9 @@ FlEdit::FlEdit(int W, int H) : Fl_Double_Window(W, H, "flEdit"), Message(CONFIG)
     _tabs.boxtype     = FL_MAX_BOXTYPE;
     _tabs.pos1        = flw::TabsGroup::Pos::TOP;
     _tabs.pos2        = flw::TabsGroup::Pos::TOP;
-    _project          = { "", "", "" };
+    _project          = { "", "", "", PROJECT_IGNORE, false };
+    _project_find     = nullptr;
+    _project_index    = nullptr;
     _paths.start_path = gnu::file::work_dir().filename();
     add(_menu);
     add(_split_main);
@@ -27451,7 +32058,8 @@ FlEdit::FlEdit(int W, int H) : Fl_Double_Window(W, H, "flEdit"), Message(CONFIG)
     _menu->add(MENU_FILE_TERMINATE,             0,                              FLEDIT_CB1(file_terminate()));
     _menu->add(MENU_FILE_QUIT,                  FL_COMMAND + 'q',               FLEDIT_CB1(quit()));
     _menu->add(MENU_FIND_SHOW,                  FL_CTRL + 'f',                  FLEDIT_CB1(show_find()));
-    _menu->add(MENU_FIND_LINES,                 FL_CTRL + 'j',                  FLEDIT_CB1(tabs_find_lines()), FL_MENU_DIVIDER);
+    _menu->add(MENU_FIND_LINES,                 FL_CTRL + 'j',                  FLEDIT_CB1(tabs_find_lines()));
+    _menu->add(MENU_FIND_PROJECT,               FL_CTRL + FL_ALT + 'j',         FLEDIT_CB1(project_find_lines()), FL_MENU_DIVIDER);
     _menu->add(MENU_FIND_REPLACE,               FL_CTRL + FL_SHIFT + 'j',       FLEDIT_CB1(tabs_replace_all()));
     _menu->add(MENU_FIND_TRAILING,              0,                              FLEDIT_CB1(tabs_trailing_all()));
     _menu->add(MENU_TOOLS_CMDREPEAT,            FL_F + 8,                       FLEDIT_CB1(tools_run_command(true)));
@@ -27488,6 +32096,8 @@ FlEdit::FlEdit(int W, int H) : Fl_Double_Window(W, H, "flEdit"), Message(CONFIG)
     _menu->add(MENU_PROJECT_CLOSE,              0,                              FLEDIT_CB1(project_close(true)));
     _menu->add(MENU_PROJECT_CLOSE2,             0,                              FLEDIT_CB1(project_close(false)), FL_MENU_DIVIDER);
     _menu->add(MENU_PROJECT_DIR,                0,                              FLEDIT_CB1(project_path()));
+    _menu->add(MENU_PROJECT_IGNORE,             0,                              FLEDIT_CB1(project_find_ignore()));
+    _menu->add(MENU_PROJECT_INDEX,              0,                              FLEDIT_CB1(project_find_index()), FL_MENU_TOGGLE);
     _menu->add(MENU_PROJECT_WORDFILE,           0,                              FLEDIT_CB1(project_wordlist()), FL_MENU_DIVIDER);
     _menu->add(MENU_PROJECT_DB_OPEN,            0,                              FLEDIT_CB1(project_open_db()));
     _menu->add(MENU_PROJECT_DB_DEFRAG,          0,                              FLEDIT_CB1(project_defrag_db()));
@@ -27526,7 +32136,9 @@ FlEdit::FlEdit(int W, int H) : Fl_Double_Window(W, H, "flEdit"), Message(CONFIG)
     _menu->add(MENU_DEBUG_COMPARE,              0,                              FLEDIT_CB1(debug_compare()), FL_MENU_DIVIDER);
 #endif
     _menu->add(MENU_DEBUG_PGO_RUN,              0,                              FLEDIT_CB1(tabs_pgo()));
+    _menu->add(MENU_DEBUG_PGO_SEARCH,           0,                              FLEDIT_CB1(tabs_pgo_search()));
     _menu->add(MENU_DEBUG_PGO_UNDO,             0,                              FLEDIT_CB1(tabs_pgo_undo()));
+    _menu->add(MENU_DEBUG_PGO_UNDO_BENCHMARK,   0,                              FLEDIT_CB1(tabs_pgo_undo_benchmark()));
     if (_PGO == false) {
         flw::menu::get_item(_menu, MENU_DEBUG_PGO)->hide();
     }
@@ -27544,8 +32156,43 @@ FlEdit::~FlEdit() {
     for (auto c : Command::COMMANDS) {
         delete c;
     }
+    Fl::remove_timeout(FlEdit::CallbackProjectFind);
+    delete _project_find;
+    delete _project_index;
     delete _recent;
 }
+int FlEdit::Benchmark(int argc, const char** argv) {
+    struct Engine {
+        const char*             name;
+        bool                    buffer;
+        bool                    compress;
+    };
+    auto engines = std::vector<Engine>{ { "VectorStore", false, false }, { "BufferStore", true, false }, { "BlockStore", true, true } };
+    fle::TextBuffer::TIMEOUT_LONG = INT_MAX;
+    fle::TextBuffer::TIMEOUT_UNDO = INT_MAX;
+    CONFIG.pref_undo = fle::FUndoMode::FLE_V1;
+    for (int f = 2; f < argc; f++) {
+        auto file = gnu::file::File(argv[f]);
+        auto buf  = gnu::file::read(file.filename());
+        if (buf.c_str() == nullptr) {
+            continue;
+        }
+        printf("%s\n", file.filename().c_str());
+        for (const auto& engine : engines) {
+            CONFIG.pref_undo_buffer   = engine.buffer;
+            CONFIG.pref_undo_compress = engine.compress;
+            auto style  = fle::Style::MakeFromFile(file);
+            auto buffer = fle::TextBuffer(nullptr, CONFIG);
+            buffer.set(buf.c_str(), fle::FChecksum::NO);
+            printf("    %-12s%s\n", engine.name, buffer.edit_benchmark(style).c_str());
+            fflush(stdout);
+            delete style;
+        }
+        printf("    %-12s%s\n", "WordList", fle::WordScanner::Benchmark(buf.c_str(), buf.size()).c_str());
+        fflush(stdout);
+    }
+    return 0;
+}
 void FlEdit::CallbackFileBrowser(Fl_Widget*, void*) {
     FlEdit::SELF->file_load(FlEdit::SELF->_editor, FlEdit::SELF->_dir_browser->file());
     FlEdit::SELF->tabs_check_empty();
@@ -27555,34 +32202,55 @@ void FlEdit::CallbackList(Fl_Widget*, void*) {
     FlEdit::SELF->callback_list();
 }
 void FlEdit::callback_list() {
-    auto  list = _output->list();
-    auto& rx   = _output->list_rx();
-    auto  row  = list->value();
+    auto  list    = _output->list();
+    auto& results = list->results();
+    auto  row     = list->value();
     if (row == 0) {
         return;
     }
-    else if (rx.pattern() == "") {
+    else if (results.has_location(row - 1) == true && results.file(row - 1) != "") {
+        return tabs_activate_cursor(Command::WORKDIR, results.file(row - 1), results.line(row - 1), results.col(row - 1));
+    }
+    if (_editor != nullptr) {
+        _editor->view().take_focus();
+    }
+}
+void FlEdit::CallbackProjectFind(void*) {
+    auto self = FlEdit::SELF;
+    auto find = self->_project_find;
+    if (find == nullptr) {
         return;
     }
-    else if (rx.is_compiled() == false) {
-        flw::dlg::msg_alert("flEdit", flw::util::format("Regex expression error!\n%s\n%s", _list_rx.err().c_str(), _list_rx.pattern().c_str()));
+    auto running = find->is_running();
+    auto lines   = find->take_lines();
+    if (lines.size() > 0) {
+        self->_output->add_list_data(lines);
+    }
+    lines.clear();
+    if (running == true) {
+        self->_findbar->statusbar().label_message(gnu::str::format("searched %u files, found %u lines", (unsigned) find->count_files(), (unsigned) find->count_lines()));
+        Fl::repeat_timeout(0.1, FlEdit::CallbackProjectFind);
         return;
     }
-    auto text    = list->text(row);
-    auto matches = rx.set_names({"file", "line", "col"}).exec(text, strlen(text));
-    if (matches.size() > 1) {
-        gnu::pcre8::Match f    = rx.match("file");
-        gnu::pcre8::Match l    = rx.match("line");
-        gnu::pcre8::Match c    = rx.match("col");
-        int               line = (int) gnu::str::to_int(l.word(), 1);
-        int               col  = (int) gnu::str::to_int(c.word(), 1);
-        if (f.word() != "") {
-            return tabs_activate_cursor(Command::WORKDIR, f.word(), line, col);
-        }
+    if (find->has_reached_limit() == true) {
+        lines.add("Error: max number of lines has been reached!");
     }
-    if (_editor != nullptr) {
-        _editor->view().take_focus();
+    else if (find->is_cancelled() == true) {
+        lines.add("Search was cancelled!");
+    }
+    if (self->_project_index != nullptr && self->_project.index == true) {
+        self->_project_index->update(find->index_updates(), find->index_dirs(), find->index_seen(), find->is_cancelled() == false);
+        if (self->_project_index->save(self->_db) == false) {
+            lines.add(gnu::str::format("Error: failed to save project index! %s", self->_db.err_msg.c_str()));
+        }
+        lines.add(gnu::str::format("Skipped %u files using the project index, %u files were reindexed", (unsigned) find->count_skipped(), (unsigned) find->index_updates().size()));
     }
+    lines.add(gnu::str::format("Found %u lines in %u files", (unsigned) find->count_lines(), (unsigned) find->count_files()));
+    self->_output->add_list_data(lines);
+    self->_findbar->statusbar().label_message(lines.text(lines.size() - 1));
+    delete find;
+    self->_project_find = nullptr;
+    self->update_menu();
 }
 void FlEdit::CallbackRecent(Fl_Widget*, void*) {
     FlEdit::SELF->file_load(FlEdit::SELF->_editor, FlEdit::SELF->_menu->text(), true);
@@ -27595,6 +32263,54 @@ void FlEdit::CallbackWindow(Fl_Widget*, void*) {
     }
     FlEdit::SELF->quit();
 }
+void FlEdit::ThreadFuncForFindLines(std::vector<FindLinesJob>* jobs, std::atomic<size_t>* next, std::atomic<size_t>* done, std::atomic<bool>* cancel, std::string find, const gnu::pcre8::PCRE* rx, const fle::MultiSearch* terms, fle::FScope fscope, fle::FTrim ftrim) {
+    while (*cancel == false) {
+        auto index = (*next)++;
+        if (index >= jobs->size()) {
+            break;
+        }
+        auto& job = (*jobs)[index];
+        fle::TextBuffer::FindLines(job.filename, job.text, job.length, find, rx, terms, job.style, fscope, ftrim, job.lines, cancel);
+        (*done)++;
+    }
+}
+void FlEdit::ThreadFuncForReplaceAll(std::vector<ReplaceAllJob>* jobs, std::atomic<size_t>* next, std::atomic<size_t>* done, std::atomic<bool>* cancel, std::string find, std::string replace) {
+    while (*cancel == false) {
+        auto index = (*next)++;
+        if (index >= jobs->size()) {
+            break;
+        }
+        auto& job = (*jobs)[index];
+        job.count = fle::TextBuffer::ReplaceAll(
+            job.text,
+            job.length,
+            job.style,
+            find,
+            replace,
+            fle::ReplaceDialog::REGEX,
+            fle::ReplaceDialog::CASECOMPARE,
+            fle::ReplaceDialog::WORDCOMPARE,
+            fle::ReplaceDialog::NLTAB,
+            fle::ReplaceDialog::SCOPE,
+            job.result,
+            cancel
+        );
+        free(job.style);
+        free(job.text);
+        job.style = nullptr;
+        job.text  = nullptr;
+        (*done)++;
+    }
+}
+int FlEdit::UndoEditors(const std::vector<fle::Editor*>& editors) {
+    auto count = 0;
+    for (auto editor : editors) {
+        if (editor->undo(fle::FUndoRange::ONE) > 0) {
+            count++;
+        }
+    }
+    return count;
+}
 void FlEdit::debug() {
 #ifdef DEBUG
     printf("\nFlEdit:\n");
@@ -27643,6 +32359,7 @@ void FlEdit::help_about() {
     size_t        B = 0;
     size_t        S = 0;
     size_t        U = 0;
+    size_t        R = 0;
     size_t        T = 0;
     size_t        C = 0;
     size_t        L = 0;
@@ -27650,11 +32367,13 @@ void FlEdit::help_about() {
         size_t b = 0;
         size_t s = 0;
         size_t u = 0;
-        T += editor->memory_usage(b, s, u);
+        size_t r = 0;
+        T += editor->memory_usage(b, s, u, r);
         L += editor->count_lines();
         B += b;
         S += s;
         U += u;
+        R += r;
         C += 1;
         editor = tabs_editor_by_index(tabindex);
     }
@@ -27676,6 +32395,8 @@ void FlEdit::help_about() {
     text += "Style memory:        " + gnu::str::format("%13s", gnu::str::format_int(S, '\'').c_str()) + "\n";
     if (CONFIG.has_fle_undo() == true) {
     text += "Undo capacity:       " + gnu::str::format("%13s", gnu::str::format_int(U, '\'').c_str()) + "\n";
+    text += "Undo uncompressed:   " + gnu::str::format("%13s", gnu::str::format_int(R, '\'').c_str()) + "\n";
+    text += "Undo ratio:          " + gnu::str::format("%13.2f", (U > 0) ? (double) R / U : 1.0) + "\n";
     }
     text += "Total memory:        " + gnu::str::format("%13s", gnu::str::format_int(T, '\'').c_str()) + "\n";
     text += "\n";
@@ -27956,6 +32677,7 @@ void FlEdit::update_menu() {
     flw::menu::enable_item(_menu, MENU_FILE_SAVE_ALL, tabs_count());
     flw::menu::enable_item(_menu, MENU_FILE_CLOSE_ALL, tabs_count());
     flw::menu::enable_item(_menu, MENU_FIND_LINES, tabs_count());
+    flw::menu::enable_item(_menu, MENU_FIND_PROJECT, _project.path != "");
     flw::menu::enable_item(_menu, MENU_FIND_REPLACE, tabs_count());
     flw::menu::enable_item(_menu, MENU_FIND_TRAILING, tabs_count());
     if (_db.is_open() == true) {
@@ -27988,6 +32710,9 @@ void FlEdit::update_menu() {
         flw::menu::enable_item(_menu, MENU_PROJECT_CLOSE, true);
         flw::menu::enable_item(_menu, MENU_PROJECT_CLOSE2, true);
         flw::menu::enable_item(_menu, MENU_PROJECT_DIR, true);
+        flw::menu::enable_item(_menu, MENU_PROJECT_IGNORE, true);
+        flw::menu::enable_item(_menu, MENU_PROJECT_INDEX, _db.is_open());
+        flw::menu::set_item(_menu, MENU_PROJECT_INDEX, _project.index);
         flw::menu::enable_item(_menu, MENU_PROJECT_RENAME, true);
         flw::menu::enable_item(_menu, MENU_PROJECT_WORDFILE, true);
         flw::menu::enable_item(_menu, MENU_VIEW_TOGGLE_BROWSER, _project.path != "");
@@ -28003,6 +32728,9 @@ void FlEdit::update_menu() {
         flw::menu::enable_item(_menu, MENU_PROJECT_CLOSE, false);
         flw::menu::enable_item(_menu, MENU_PROJECT_CLOSE2, false);
         flw::menu::enable_item(_menu, MENU_PROJECT_DIR, false);
+        flw::menu::enable_item(_menu, MENU_PROJECT_IGNORE, false);
+        flw::menu::enable_item(_menu, MENU_PROJECT_INDEX, false);
+        flw::menu::set_item(_menu, MENU_PROJECT_INDEX, false);
         flw::menu::enable_item(_menu, MENU_PROJECT_RENAME, false);
         flw::menu::enable_item(_menu, MENU_PROJECT_WORDFILE, false);
         flw::menu::enable_item(_menu, MENU_VIEW_TOGGLE_BROWSER, false);
@@ -28053,6 +32781,7 @@ bool FlEdit::editor_close(fle::Editor* editor, bool ask) {
             return false;
         }
     }
+    project_save_undo_to_db(editor);
     _recent->insert(editor->filename_long());
     tabs_delete(editor);
     return true;
@@ -28132,6 +32861,9 @@ fle::Editor* FlEdit::file_load(Fl_Widget* after, const std::string& filename, bo
     if (add_recent == true) {
         _recent->insert(fi.filename());
     }
+    if (as_hex == false) {
+        project_load_undo_from_db(editor);
+    }
     if (line > 0) {
         editor->cursor_move_to_rowcol(line, 1);
     }
@@ -28485,7 +33217,10 @@ bool FlEdit::project_close(bool save) {
         _recent->clear();
         _recent->items(_old_recent_list);
     }
-    _project = { "", "", "" };
+    _project = { "", "", "", PROJECT_IGNORE, false };
+    project_find_stop();
+    delete _project_index;
+    _project_index = nullptr;
     CONFIG.load_custom_wordlist("");
     tabs_close_all();
     split_view(Split::HIDE_TWO);
@@ -28508,6 +33243,83 @@ void FlEdit::project_defrag_db() {
         flw::dlg::msg_alert("flEdit", flw::util::format("Failed to defrag database file!\n%s", _db.err_msg.c_str()));
     }
 }
+void FlEdit::project_find_ignore() {
+    auto ignore = _project.ignore;
+    if (flw::dlg::input("flEdit", "Enter file and directory names to skip in find in project.\nSeparate patterns with ';'.", ignore, 60) != flw::label::CANCEL) {
+        _project.ignore = ignore;
+    }
+}
+void FlEdit::project_find_index() {
+    _project.index = flw::menu::item_value(_menu, MENU_PROJECT_INDEX);
+    if (_project.index == false) {
+        project_find_stop();
+        delete _project_index;
+        _project_index = nullptr;
+    }
+}
+void FlEdit::project_find_lines() {
+    if (_project_find != nullptr) {
+        _project_find->cancel();
+        return;
+    }
+    else if (Command::THREAD != nullptr) {
+        flw::dlg::msg_alert("flEdit", "Can't search for text while running an command!");
+        return;
+    }
+    else if (_project.path == "") {
+        flw::dlg::msg_alert("flEdit", "Error: project directory has not been set!");
+        return;
+    }
+    auto find = std::string();
+    {
+        auto list   = CONFIG.find_list;
+        auto dialog = fle::FindDialog("Find Lines In Project", list);
+        find        = dialog.run();
+        if (find == "") {
+            return;
+        }
+    }
+    if (_project_index != nullptr && _project_index->path() != gnu::file::File(_project.path).filename()) {
+        project_find_stop();
+        delete _project_index;
+        _project_index = nullptr;
+    }
+    if (_project.index == true && _project_index == nullptr && _db.is_open() == true) {
+    #ifdef DEBUG
+        auto time = gnu::Time::Milli();
+    #endif
+        _project_index = new ProjectIndex(_project.path);
+        _project_index->load(_db);
+    #ifdef DEBUG
+        printf("loaded project index with %d files in %d mS\n", (int) _project_index->count_files(), (int) (gnu::Time::Milli() - time));
+        fflush(stdout);
+    #endif
+    }
+    _project_find = new ProjectFind(_project.path, find, fle::FindDialog::REGEX, fle::FindDialog::TERMS, fle::FindDialog::CASE, fle::FindDialog::TRIM, _project.ignore, (_project.index == true) ? _project_index : nullptr);
+    if (_project_find->start() == false) {
+        flw::dlg::msg_alert("flEdit", _project_find->err());
+        delete _project_find;
+        _project_find = nullptr;
+        return;
+    }
+    Command::WORKDIR = _project.path;
+    _findbar->findreplace().add_find_word(find);
+    auto results = fle::ResultStore();
+    results.add(gnu::str::format("searching for <%s> in %s", find.c_str(), _project.path.c_str()));
+    _output->set_list_data(results, 0);
+    _output->show();
+    do_layout();
+    Fl::add_timeout(0.1, FlEdit::CallbackProjectFind);
+}
+void FlEdit::project_find_stop() {
+    Fl::remove_timeout(FlEdit::CallbackProjectFind);
+    if (_project_find != nullptr) {
+        _project_find->cancel();
+        delete _project_find;
+        _project_find = nullptr;
+        update_menu();
+    }
+}
 bool FlEdit::project_exist_in_db(const std::string& project_name) {
     if (_db.is_open() == false) {
         return false;
@@ -28623,6 +33435,8 @@ void FlEdit::project_load_from_db(const std::string& project_name) {
         _project.name     = name;
         _project.path     = pile.get_string("gui", "dir");
         _project.wordfile = pile.get_string("project", "wordfile");
+        _project.ignore   = pile.get_string("project", "ignore", PROJECT_IGNORE);
+        _project.index    = pile.get_int("project", "index") != 0;
     #ifdef DEBUG
         printf("loaded project %s in %d mS with %d files\n", _project.name.c_str(), (int) time, (int) files);
         fflush(stdout);
@@ -28675,6 +33489,52 @@ void FlEdit::project_load_snippet_from_db() {
         KLUDGE--;
     }
 }
+bool FlEdit::project_load_undo_from_db(fle::Editor* editor) {
+    auto undo  = editor->buffer().undo();
+    auto store = (undo != nullptr) ? dynamic_cast<fle::undo::BlockStore*>(undo->store()) : nullptr;
+    if (_db.is_open() == false || store == nullptr || undo->has_undo() == true || undo->has_redo() == true || editor->filename_long() == "") {
+        return false;
+    }
+    auto row = _db.get(NS_UNDO, editor->filename_long());
+    if (row.c_str() == nullptr) {
+        return false;
+    }
+    auto pile = gnu::pile::Pile(row.c_str());
+    if (pile.get_string("undo", "checksum") != editor->text_checksum() || editor->text_checksum() == "") {
+        return false;
+    }
+    else if (pile.get_int("undo", "format") != fle::undo::Store::FORMAT) {
+        return false;
+    }
+    auto blocks = std::vector<fle::undo::BlockStore::Block>();
+    auto count  = pile.get_int("undo", "blocks");
+    auto hot    = std::string();
+    for (auto f = 0; f < count; f++) {
+        auto section = gnu::pile::make_key(f);
+        auto data    = _db.get(NS_UNDO, editor->filename_long() + "|" + section);
+        auto block   = fle::undo::BlockStore::Block();
+        if (data.c_str() == nullptr) {
+            return false;
+        }
+        block.data   = std::string(data.c_str(), data.size());
+        block.end    = pile.get_int(section, "end");
+        block.hash   = static_cast<uint64_t>(pile.get_int(section, "hash"));
+        block.offset = -1;
+        block.packed = pile.get_int(section, "packed") == 1;
+        block.size   = block.data.length();
+        block.start  = pile.get_int(section, "start");
+        blocks.push_back(std::move(block));
+    }
+    auto data = _db.get(NS_UNDO, editor->filename_long() + "|hot");
+    if (data.c_str() == nullptr || fle::undo::BlockStore::Decompress(data.c_str(), data.size(), hot, pile.get_int("undo", "hot")) == false) {
+        return false;
+    }
+    else if (store->restore(blocks, hot, pile.get_int("undo", "save_point")) == false) {
+        return false;
+    }
+    undo->restore_save_point();
+    return true;
+}
 void FlEdit::project_open_db() {
     auto filename = gnu::str::to_string(fl_file_chooser("Open/Create Project Database", "FlEdit Project Files (*.{fledit,db})", _paths.open_path.c_str()));
     if (filename == "") {
@@ -28815,6 +33675,7 @@ bool FlEdit::project_save_to_db(const std::string& name, const std::string& old_
             pile.set_int(section, "drag", cursor.drag);
             pile.set_int(section, "start", cursor.start);
             pile.set_int(section, "end", cursor.end);
+            project_save_undo_to_db(editor);
             count++;
             if (_tabs.tabs1->value() == editor) {
                 pile.set_string("active", "left", editor->filename_long());
@@ -28828,6 +33689,8 @@ bool FlEdit::project_save_to_db(const std::string& name, const std::string& old_
     pile.set_int("gui", "files", count - 1);
     pile.set_string("gui", "dir", _project.path);
     pile.set_string("project", "wordfile", _project.wordfile);
+    pile.set_string("project", "ignore", _project.ignore);
+    pile.set_int("project", "index", _project.index);
     auto str = pile.export_data();
     if (_db.put(NS_PROJECTS, name, str, -1) == false) {
         flw::dlg::msg_alert("flEdit", flw::util::format("Failed to save project!\n%s", _db.err_msg.c_str()));
@@ -28839,6 +33702,57 @@ bool FlEdit::project_save_to_db(const std::string& name, const std::string& old_
     _project.name = name;
     return true;
 }
+bool FlEdit::project_save_undo_to_db(fle::Editor* editor) {
+    auto undo  = editor->buffer().undo();
+    auto store = (undo != nullptr) ? dynamic_cast<fle::undo::BlockStore*>(undo->store()) : nullptr;
+    if (_db.is_open() == false || editor->filename_long() == "") {
+        return false;
+    }
+    else if (store == nullptr || undo->save_point() == fle::undo::Undo::SAVE_POINT_NONE || editor->text_checksum() == "" || (undo->has_undo() == false && undo->has_redo() == false)) {
+        auto old = gnu::pile::Pile(_db.get(NS_UNDO, editor->filename_long()).c_str());
+        for (auto f = 0; f < old.get_int("undo", "blocks"); f++) {
+            _db.remove(NS_UNDO, editor->filename_long() + "|" + gnu::pile::make_key(f));
+        }
+        _db.remove(NS_UNDO, editor->filename_long() + "|hot");
+        _db.remove(NS_UNDO, editor->filename_long());
+        return false;
+    }
+    auto  old    = gnu::pile::Pile(_db.get(NS_UNDO, editor->filename_long()).c_str());
+    auto  pile   = gnu::pile::Pile();
+    auto& blocks = store->blocks();
+    auto  hot    = fle::undo::BlockStore::Compress(store->hot().data(), store->hot().length());
+    auto  res    = _db.begin();
+    for (size_t f = 0; f < blocks.size(); f++) {
+        auto  section = gnu::pile::make_key(f);
+        auto& block   = blocks[f];
+        pile.set_int(section, "start", block.start);
+        pile.set_int(section, "end", block.end);
+        pile.set_int(section, "packed", block.packed ? 1 : 0);
+        pile.set_int(section, "hash", static_cast<int64_t>(block.hash));
+        if (old.get_int(section, "start", -1) == block.start && old.get_int(section, "end", -1) == block.end && static_cast<uint64_t>(old.get_int(section, "hash")) == block.hash) {
+            continue;
+        }
+        auto data = store->block_data(f);
+        res = res && data.length() == block.size && _db.put(NS_UNDO, editor->filename_long() + "|" + section, data);
+    }
+    for (auto f = static_cast<int64_t>(blocks.size()); f < old.get_int("undo", "blocks"); f++) {
+        _db.remove(NS_UNDO, editor->filename_long() + "|" + gnu::pile::make_key(f));
+    }
+    pile.set_string("undo", "checksum", editor->text_checksum());
+    pile.set_int("undo", "blocks", blocks.size());
+    pile.set_int("undo", "format", fle::undo::Store::FORMAT);
+    pile.set_int("undo", "hot", store->hot().length());
+    pile.set_int("undo", "save_point", undo->save_point());
+    res = res && _db.put(NS_UNDO, editor->filename_long() + "|hot", hot);
+    res = res && _db.put(NS_UNDO, editor->filename_long(), pile.export_data());
+    if (res == true) {
+        _db.commit();
+    }
+    else {
+        _db.rollback();
+    }
+    return res;
+}
 void FlEdit::project_wordlist() {
     auto start_path = _project.path;
     if (start_path == "") {
@@ -28931,6 +33845,14 @@ void FlEdit::tabs_activate_cursor(const std::string& workpath, const std::string
         }
         tabs_activate(partly);
     }
+    else if (fi.is_file() == true && (found = file_load(_editor, fi.filename())) != nullptr) {
+        if (row > 0) {
+            found->cursor_move_to_rowcol(row, col);
+        }
+        tabs_check_empty();
+        tabs_activate(found);
+        do_layout();
+    }
     else if (_editor != nullptr) {
         _editor->view().take_focus();
     }
@@ -28999,7 +33921,13 @@ void FlEdit::tabs_check_external_update() {
     }
 }
 void FlEdit::tabs_close_all() {
-    auto wc = flw::WaitCursor();
+    auto wc       = flw::WaitCursor();
+    auto tabindex = 0;
+    auto editor   = tabs_editor_by_index(tabindex);
+    while (editor != nullptr) {
+        project_save_undo_to_db(editor);
+        editor = tabs_editor_by_index(tabindex);
+    }
     _editor = nullptr;
     _tabs.tabs1->clear();
     _tabs.tabs2->clear();
@@ -29079,22 +34007,77 @@ void FlEdit::tabs_find_lines() {
     {
         auto tabindex = 0;
         auto editor   = tabs_editor_by_index(tabindex);
-        auto lines    = std::vector<std::string>();
+        auto jobs     = std::vector<FindLinesJob>();
+        auto lines    = fle::ResultStore();
         auto files    = (size_t) 0;
+        auto unstyled = 0;
+        auto rx       = (fle::FindDialog::REGEX == fle::FRegex::YES) ? new gnu::pcre8::PCRE(find, true) : (gnu::pcre8::PCRE*) nullptr;
+        auto terms    = (fle::FindDialog::REGEX == fle::FRegex::NO && fle::FindDialog::TERMS == fle::FTerms::YES) ? new fle::MultiSearch(fle::MultiSearch::Split(find), fle::FindDialog::CASE == fle::FCaseCompare::YES) : (fle::MultiSearch*) nullptr;
         while (editor != nullptr) {
-            if (editor->find_lines(find, fle::FindDialog::REGEX, fle::FindDialog::TRIM, lines) > 0) {
-                files++;
+            if (editor->buffer().has_scope_style(fle::FindDialog::SCOPE) == false) {
+                unstyled++;
+            }
+            else {
+                auto style = (fle::FindDialog::SCOPE != fle::FScope::ALL) ? editor->style_buffer().text() : nullptr;
+                jobs.push_back(FindLinesJob(editor->filename_short(), editor->buffer().text(), style, editor->text_length()));
             }
             editor = tabs_editor_by_index(tabindex);
         }
-        if (lines.size() > 0) {
+        auto cancel   = std::atomic<bool>(false);
+        auto done     = std::atomic<size_t>(0);
+        auto next     = std::atomic<size_t>(0);
+        auto threads  = std::vector<std::thread>();
+        auto count    = std::min(jobs.size(), static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1u)));
+        auto progress = (flw::dlg::Progress*) nullptr;
+        auto start    = gnu::Time::Milli();
+        for (size_t f = 0; f < count; f++) {
+            threads.push_back(std::thread(FlEdit::ThreadFuncForFindLines, &jobs, &next, &done, &cancel, find, rx, terms, fle::FindDialog::SCOPE, fle::FindDialog::TRIM));
+        }
+        while (done < jobs.size()) {
+            if (progress == nullptr && gnu::Time::Milli() - start > fle::TextBuffer::TIMEOUT_LONG) {
+                progress = new flw::dlg::Progress("Find Lines In All Files", true, false, 0.0, static_cast<double>(jobs.size()));
+                progress->start();
+            }
+            if (progress != nullptr && progress->update(static_cast<double>(done), gnu::str::format("searched %u of %u files", (unsigned) done, (unsigned) jobs.size()), 50) == false) {
+                cancel = true;
+                break;
+            }
+            flw::util::sleep(5);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (auto& job : jobs) {
+            if (job.lines.size() > 0 && (fle::limits::OUTPUT_LINES_VAL == 0 || lines.size() < fle::limits::OUTPUT_LINES_VAL)) {
+                files++;
+                if (fle::limits::OUTPUT_LINES_VAL > 0 && lines.size() + job.lines.size() > fle::limits::OUTPUT_LINES_VAL) {
+                    lines.append(job.lines, fle::limits::OUTPUT_LINES_VAL - lines.size());
+                    lines.add("Error: max number of lines has been reached!");
+                }
+                else {
+                    lines.append(job.lines);
+                }
+            }
+            free(job.style);
+            free(job.text);
+        }
+        delete progress;
+        delete rx;
+        delete terms;
+        if (cancel == true) {
+            _findbar->statusbar().label_message(gnu::str::format("search was cancelled, found %u lines in %u files", (unsigned) lines.size(), (unsigned) files));
+        }
+        else if (lines.size() > 0) {
             _findbar->findreplace().add_find_word(find);
             _findbar->statusbar().label_message(gnu::str::format("found %u lines in %u files", (unsigned) lines.size(), (unsigned) files));
         }
         else {
             _findbar->statusbar().label_message(gnu::str::format("unable to find <%s>", find.c_str()));
         }
-        _output->set_list_data(lines, "(?<file>.+):\\s+(?<line>\\d+)\\s+-\\s+(?<col>\\d+).*", 0);
+        if (unstyled > 0) {
+            lines.add(gnu::str::format("Error: %d files are not styled yet and were skipped", unstyled));
+        }
+        _output->set_list_data(lines, 0);
         _output->show();
         _output->show_main_editor();
         do_layout();
@@ -29161,8 +34144,8 @@ void FlEdit::tabs_pgo() {
     auto tabindex = 0;
     auto tmp      = tabs_editor_by_index(tabindex);
     while (tmp != nullptr) {
-        tmp->find_replace_all(" ", "XX", fle::FNlTab::NO, fle::FSelection::NO, fle::FCaseCompare::YES, fle::FWordCompare::NO, fle::FRegex::NO, fle::FSaveWord::NO, fle::FHideFind::YES);
-        tmp->find_replace_all("^X", "y", fle::FNlTab::NO, fle::FSelection::NO, fle::FCaseCompare::YES, fle::FWordCompare::NO, fle::FRegex::YES, fle::FSaveWord::NO, fle::FHideFind::YES);
+        tmp->find_replace_all(" ", "XX", fle::FNlTab::NO, fle::FSelection::NO, fle::FCaseCompare::YES, fle::FWordCompare::NO, fle::FRegex::NO, fle::FScope::ALL, fle::FSaveWord::NO, fle::FHideFind::YES);
+        tmp->find_replace_all("^X", "y", fle::FNlTab::NO, fle::FSelection::NO, fle::FCaseCompare::YES, fle::FWordCompare::NO, fle::FRegex::YES, fle::FScope::ALL, fle::FSaveWord::NO, fle::FHideFind::YES);
         tmp->cursor_move_to_pos(tmp->text_length() / 2, true);
         tmp->text_select_line();
         for (int f = 0; f < 100; f++) {
@@ -29171,6 +34154,18 @@ void FlEdit::tabs_pgo() {
         tmp = tabs_editor_by_index(tabindex);
     }
 }
+void FlEdit::tabs_pgo_search() {
+    auto tabindex = 0;
+    auto tmp      = tabs_editor_by_index(tabindex);
+    auto lines    = std::vector<std::string>();
+    while (tmp != nullptr) {
+        lines.push_back(tmp->filename_short());
+        lines.push_back(std::string("    \"int\"    ") + tmp->buffer().search_benchmark("int", true));
+        lines.push_back(std::string("    \"RETURN\" ") + tmp->buffer().search_benchmark("RETURN", false));
+        tmp = tabs_editor_by_index(tabindex);
+    }
+    flw::dlg::list("Search Benchmark", lines, true, 120, 30);
+}
 void FlEdit::tabs_pgo_undo() {
     auto tabindex = 0;
     auto tmp      = tabs_editor_by_index(tabindex);
@@ -29179,6 +34174,14 @@ void FlEdit::tabs_pgo_undo() {
         tmp = tabs_editor_by_index(tabindex);
     }
 }
+void FlEdit::tabs_pgo_undo_benchmark() {
+    auto wc    = flw::WaitCursor();
+    auto lines = std::vector<std::string>();
+    lines.push_back(fle::undo::Undo::Benchmark(new fle::undo::VectorStore(), "VectorStore"));
+    lines.push_back(fle::undo::Undo::Benchmark(new fle::undo::BufferStore(), "BufferStore"));
+    lines.push_back(fle::undo::Undo::Benchmark(new fle::undo::BlockStore(), "BlockStore"));
+    flw::dlg::list("Undo Benchmark", lines, true, 120, 10);
+}
 void FlEdit::tabs_replace_all() {
     tabs_check_external_update();
     auto find    = std::string();
@@ -29187,6 +34190,116 @@ void FlEdit::tabs_replace_all() {
     if (dialog.run() == false) {
         return;
     }
+    else if (fle::ReplaceDialog::SELECTION == fle::FSelection::YES) {
+        tabs_replace_all_in_selection(find, replace);
+        return;
+    }
+    else if (fle::ReplaceDialog::REGEX == fle::FRegex::YES && gnu::pcre8::PCRE(find, true).is_compiled() == false) {
+        _findbar->statusbar().label_message(gnu::str::format("invalid regular expression <%s>", find.c_str()));
+        return;
+    }
+    auto time     = gnu::Time::Milli();
+    auto tabindex = 0;
+    auto editor   = tabs_editor_by_index(tabindex);
+    auto jobs     = std::vector<ReplaceAllJob>();
+    auto unstyled = 0;
+    auto scoped   = fle::ReplaceDialog::SCOPE != fle::FScope::ALL;
+    while (editor != nullptr) {
+        if (editor->text_is_readonly() == false && scoped == true && editor->style_buffer().length() != editor->text_length()) {
+            unstyled++;
+        }
+        else if (editor->text_is_readonly() == false) {
+            jobs.push_back(ReplaceAllJob(editor, editor->buffer().text(), (scoped == true) ? editor->style_buffer().text() : nullptr, editor->text_length(), editor->buffer().revision()));
+        }
+        editor = tabs_editor_by_index(tabindex);
+    }
+    auto cancel   = std::atomic<bool>(false);
+    auto done     = std::atomic<size_t>(0);
+    auto next     = std::atomic<size_t>(0);
+    auto threads  = std::vector<std::thread>();
+    auto count    = std::min(jobs.size(), static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1u)));
+    auto progress = (flw::dlg::Progress*) nullptr;
+    for (size_t f = 0; f < count; f++) {
+        threads.push_back(std::thread(FlEdit::ThreadFuncForReplaceAll, &jobs, &next, &done, &cancel, find, replace));
+    }
+    while (done < jobs.size()) {
+        if (progress == nullptr && gnu::Time::Milli() - time > fle::TextBuffer::TIMEOUT_LONG) {
+            progress = new flw::dlg::Progress("Replace Text In All Files", true, false, 0.0, static_cast<double>(jobs.size()));
+            progress->start();
+        }
+        if (progress != nullptr && progress->update(static_cast<double>(done), gnu::str::format("searched %u of %u files", (unsigned) done, (unsigned) jobs.size()), 50) == false) {
+            cancel = true;
+            break;
+        }
+        flw::util::sleep(5);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    delete progress;
+    auto labels   = StringVector();
+    auto selected = StringVector();
+    auto files    = 0;
+    auto replaces = 0;
+    auto skipped  = 0;
+    for (const auto& job : jobs) {
+        if (job.count > 0) {
+            labels.push_back(gnu::str::format("1%s (%d)", job.editor->filename_short().c_str(), job.count));
+        }
+    }
+    time = gnu::Time::Milli() - time;
+    if (cancel == false && labels.size() > 0) {
+        selected = flw::dlg::select_checkboxes(gnu::str::format("Replace <%s> with <%s> in %u files?", find.c_str(), replace.c_str(), (unsigned) labels.size()), labels);
+    }
+    if (selected.size() > 0) {
+        auto wc    = flw::WaitCursor();
+        auto index = (size_t) 0;
+        auto start = gnu::Time::Milli();
+        for (const auto& job : jobs) {
+            if (job.count == 0 || selected[index++][0] != '1') {
+                continue;
+            }
+            if (job.editor->buffer().revision() != job.revision) {
+                skipped++;
+            }
+            else if (job.editor->find_replace_commit(job.result, job.count) > 0) {
+                replaces += job.count;
+                files++;
+            }
+        }
+        time += gnu::Time::Milli() - start;
+        _findbar->findreplace().add_find_word(find);
+        _findbar->findreplace().add_replace_word(replace);
+    }
+    for (auto& job : jobs) {
+        free(job.style);
+        free(job.text);
+    }
+    if (_editor != nullptr) {
+        _editor->view().take_focus();
+    }
+    auto message = std::string();
+    if (cancel == true) {
+        message = "replace was cancelled, no files were changed";
+    }
+    else if (labels.size() == 0) {
+        message = gnu::str::format("unable to find <%s> in any file!", find.c_str());
+    }
+    else if (selected.size() == 0 || files == 0) {
+        message = (skipped > 0) ? gnu::str::format("%d files changed during preview and were skipped", skipped) : std::string("no files were changed");
+    }
+    else if (skipped > 0) {
+        message = gnu::str::format("replaced %d strings in %d files in %d mS, %d files changed during preview and were skipped", replaces, files, time, skipped);
+    }
+    else {
+        message = gnu::str::format("replaced %d strings in %d files in %d mS", replaces, files, time);
+    }
+    if (unstyled > 0) {
+        message += gnu::str::format(" (warning: %d files are not styled yet and were skipped)", unstyled);
+    }
+    _findbar->statusbar().label_message(message);
+}
+void FlEdit::tabs_replace_all_in_selection(const std::string& find, const std::string& replace) {
     auto time     = gnu::Time::Milli();
     auto tabindex = 0;
     auto editor   = tabs_editor_by_index(tabindex);
@@ -29194,6 +34307,9 @@ void FlEdit::tabs_replace_all() {
     auto replaces = 0;
     auto org      = _editor;
     auto wc       = flw::WaitCursor();
+    auto changed  = std::vector<fle::Editor*>();
+    auto progress = (flw::dlg::Progress*) nullptr;
+    auto cancel   = false;
     while (editor != nullptr) {
         auto count = editor->find_replace_all(find, replace,
             fle::ReplaceDialog::NLTAB,
@@ -29201,18 +34317,39 @@ void FlEdit::tabs_replace_all() {
             fle::ReplaceDialog::CASECOMPARE,
             fle::ReplaceDialog::WORDCOMPARE,
             fle::ReplaceDialog::REGEX,
+            fle::ReplaceDialog::SCOPE,
             fle::FSaveWord::YES,
             fle::FHideFind::NO);
+        if (editor->buffer().cancelled() == true) {
+            cancel = true;
+            break;
+        }
+        else if (count > 0) {
+            changed.push_back(editor);
+            files++;
+        }
         editor    = tabs_editor_by_index(tabindex);
         replaces += count;
-        if (count > 0) {
-            files++;
+        if (progress == nullptr && gnu::Time::Milli() - time > fle::TextBuffer::TIMEOUT_LONG) {
+            progress = new flw::dlg::Progress("Replace Text In All Files", true);
+            progress->start();
+        }
+        if (progress != nullptr && progress->update(gnu::str::format("replaced %d strings in %d files", replaces, files), 50) == false) {
+            cancel = true;
+            break;
         }
     }
+    delete progress;
+    if (cancel == true) {
+        files = FlEdit::UndoEditors(changed);
+    }
     if (org != nullptr) {
         org->view().take_focus();
     }
-    if (replaces == 0) {
+    if (cancel == true) {
+        _findbar->statusbar().label_message(gnu::str::format("replace was cancelled, undid changes in %d files", files));
+    }
+    else if (replaces == 0) {
         _findbar->statusbar().label_message(gnu::str::format("unable to find <%s> in any file!", find.c_str()));
     }
     else {
@@ -29296,18 +34433,42 @@ void FlEdit::tabs_trailing_all() {
     auto files    = 0;
     auto lines    = 0;
     auto org      = _editor;
+    auto changed  = std::vector<fle::Editor*>();
+    auto progress = (flw::dlg::Progress*) nullptr;
+    auto cancel   = false;
+    auto time     = gnu::Time::Milli();
     while (editor != nullptr) {
         auto count = editor->text_remove_trailing();
+        if (editor->buffer().cancelled() == true) {
+            cancel = true;
+            break;
+        }
+        else if (count > 0) {
+            changed.push_back(editor);
+            files++;
+        }
         editor = tabs_editor_by_index(tabindex);
         lines += count;
-        if (count > 0) {
-            files++;
+        if (progress == nullptr && gnu::Time::Milli() - time > fle::TextBuffer::TIMEOUT_LONG) {
+            progress = new flw::dlg::Progress("Remove Trailing Whitespace", true);
+            progress->start();
+        }
+        if (progress != nullptr && progress->update(gnu::str::format("removed whitespace from %d lines in %d files", lines, files), 50) == false) {
+            cancel = true;
+            break;
         }
     }
+    delete progress;
+    if (cancel == true) {
+        files = FlEdit::UndoEditors(changed);
+    }
     if (org != nullptr) {
         org->view().take_focus();
     }
-    if (lines == 0) {
+    if (cancel == true) {
+        _findbar->statusbar().label_message(gnu::str::format("remove whitespace was cancelled, undid changes in %d files", files));
+    }
+    else if (lines == 0) {
         _findbar->statusbar().label_message("unable to remove any whitespace!");
     }
     else {
@@ -29316,6 +34477,9 @@ void FlEdit::tabs_trailing_all() {
 }
 #include <FL/platform.H>
 int main(int argc, const char** argv) {
+    if (argc > 1 && strcmp(argv[1], "--benchmark") == 0) {
+        return FlEdit::Benchmark(argc, argv);
+    }
     Fl::keyboard_screen_scaling(0);
     flw::theme::load("oxy");
     if (Fl::lock() != 0) {